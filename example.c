@@ -15,19 +15,25 @@
 
 char* test_msg = "$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B";
 
-NMEA_Message_t temp;
-NMEA_Payload_GGA_t frame_gga;
-
+void on_gga(const NMEA_Message_t* msg, const NMEA_Payload_t* frame, void* user);
 void print_gga(const NMEA_Payload_GGA_t* frame);
 
 int main(void) {
-	NMEA_Pack(&temp, test_msg);
-	
-	if( temp.payloadId == NMEA_MSG_GGA ){
-		NMEA_GGA_Parse(&frame_gga, &temp);
-		printf("TESTING MSG : %s \n\n", test_msg);
-		print_gga(&frame_gga);
-	}
+	NMEA_Parser_t parser;
+	NMEA_Handlers_t handlers;
+
+	NMEA_Parser_Init(&parser);
+	NMEA_Handlers_Init(&handlers);
+	NMEA_Handlers_Set(&handlers, NMEA_MSG_GGA, on_gga, NULL);
+
+	/* Packs, parses into the GGA frame and calls on_gga. */
+	NMEA_Dispatch(&parser, &handlers, (const uint8_t*)test_msg);
+}
+
+void on_gga(const NMEA_Message_t* msg, const NMEA_Payload_t* frame, void* user) {
+	(void)msg; (void)user;
+	printf("TESTING MSG : %s \n\n", test_msg);
+	print_gga(&frame->gga);
 }
 
 void print_gga(const NMEA_Payload_GGA_t* frame) {
@@ -20,7 +20,42 @@
  *	18.12.2023 : Compiler satisfy changes.
  *  
  *  18.01.2024 : ID search optimization.
- * 
+ *
+ *  16.10.2026 : NMEA_Parser_t context. Removed file-static cursor & ID buffers,
+ *  all Pack/Scan/Parse calls are reentrant.
+ *
+ *  16.10.2026 : NMEA_Feed, streaming byte-level framer.
+ *
+ *  16.10.2026 : Checksum validation fused into framing & packing.
+ *
+ *  16.10.2026 : Perfect hash talker & payload ID lookup, GQ/BD/GI/$P talkers.
+ *
+ *  16.10.2026 : Dedicated integer / decimal scanners, no strtol & strtod.
+ *
+ *  16.10.2026 : NMEA_Index, vectorized field separator index (SSE2/AVX2/NEON).
+ *
+ *  16.10.2026 : Specialized straight-line per-type parsers, NMEA_Scan kept
+ *  for ad-hoc formats.
+ *
+ *  16.10.2026 : GSV numMsg / msgNum field order fixed, the message count comes first.
+ *
+ *  16.10.2026 : NMEA_Dispatch, typed handlers by payload ID jump table.
+ *
+ *  16.10.2026 : NMEA_View_t, lazy field access with cached typed accessors.
+ *
+ *  16.10.2026 : NMEA_*_ParseMask, member projection for the per-type parsers.
+ *
+ *  16.10.2026 : GGA HDOP, altitude, geoid separation & differential fields.
+ *
+ *  16.10.2026 : Added DTM, GNS, GRS, TXT, VLW parsers.
+ *
+ *  16.10.2026 : Millisecond time of day, exact 1e-7 degree locations.
+ *
+ *  16.10.2026 : RMC navStatus decoded. GSV reads whole satellite blocks only, the
+ *               trailing signal ID is no longer taken for a satellite.
+ *
+ *  16.10.2026 : AVX2 separator kernel is chosen once at load time, not per chunk.
+ *
  *	References:
  *  [0] The National Marine Electronics Association (NMEA) 0183. Manual Klaus Betke, May 2000. Revised August 2001.
  *	[1] u-blox8-M8_ReceiverDescrProtSpec_(UBX-13003221)
@@ -31,13 +66,10 @@
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include <stdlib.h>
 #include <stdarg.h>
 
 #include "nmea.h"
 
-#define NMEA_MAX_MESSAGE_LEN  	80
-#define NMEA_MAX_FIELD_LEN		16
 
 #define NMEA_TALKER_ID_LEN  	2
 #define NMEA_PAYLOAD_ID_LEN 	3
@@ -45,79 +77,247 @@
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 
 
+/*
+*  Address IDs are packed little-endian into an integer key and resolved with a
+*  compile-time perfect hash: one multiply, one shift, one compare.
+*  Multipliers are searched offline for collision free slots over the tables.
+*/
+#define NMEA_ID2(a, b)		((uint32_t)(uint8_t)(a) | ((uint32_t)(uint8_t)(b) << 8))
+#define NMEA_ID3(a, b, c)	(NMEA_ID2(a, b) | ((uint32_t)(uint8_t)(c) << 16))
+
+#define NMEA_TALKER_HASH_BITS	3
+#define NMEA_TALKER_HASH_MUL	0xCF7299C7u
+#define NMEA_TALKER_HASH(key)	((uint32_t)((key) * NMEA_TALKER_HASH_MUL) >> (32 - NMEA_TALKER_HASH_BITS))
+
+#define NMEA_PAYLOAD_HASH_BITS	5
+#define NMEA_PAYLOAD_HASH_MUL	0x188EA6C1u
+#define NMEA_PAYLOAD_HASH(key)	((uint32_t)((key) * NMEA_PAYLOAD_HASH_MUL) >> (32 - NMEA_PAYLOAD_HASH_BITS))
+
 typedef struct NMEA_Identifier_s {
+	uint32_t key;
 	uint8_t id_index;
-	const char* id;
 } NMEA_Identifer_t;
 
-static const NMEA_Identifer_t TalkerID_Data[] = {
-	{NMEA_TALKER_GP, "GP"},
-	{NMEA_TALKER_GL, "GL"},
-	{NMEA_TALKER_GA, "GA"},
-	{NMEA_TALKER_GB, "GB"},
-	{NMEA_TALKER_GN, "GN"},
+#define NMEA_TALKER_SLOT(a, b, id)		[NMEA_TALKER_HASH(NMEA_ID2(a, b))] = { NMEA_ID2(a, b), id }
+#define NMEA_PAYLOAD_SLOT(a, b, c, id)	[NMEA_PAYLOAD_HASH(NMEA_ID3(a, b, c))] = { NMEA_ID3(a, b, c), id }
+
+static const NMEA_Identifer_t TalkerID_Data[1 << NMEA_TALKER_HASH_BITS] = {
+	NMEA_TALKER_SLOT('G', 'P', NMEA_TALKER_GP),
+	NMEA_TALKER_SLOT('G', 'L', NMEA_TALKER_GL),
+	NMEA_TALKER_SLOT('G', 'A', NMEA_TALKER_GA),
+	NMEA_TALKER_SLOT('G', 'B', NMEA_TALKER_GB),
+	NMEA_TALKER_SLOT('G', 'N', NMEA_TALKER_GN),
+	NMEA_TALKER_SLOT('G', 'Q', NMEA_TALKER_GQ),
+	NMEA_TALKER_SLOT('B', 'D', NMEA_TALKER_BD),
+	NMEA_TALKER_SLOT('G', 'I', NMEA_TALKER_GI),
 };
 
-static const NMEA_Identifer_t PayloadID_Data[] = {
-	{NMEA_MSG_DTM, "DTM"},
-	{NMEA_MSG_GBQ, "GBQ"},
-	{NMEA_MSG_GBS, "GBS"}, // Has NMEA Parser
-	{NMEA_MSG_GGA, "GGA"}, // Has NMEA Parser
-	{NMEA_MSG_GLL, "GLL"}, // Has NMEA Parser
-	{NMEA_MSG_GLQ, "GLQ"},
-	{NMEA_MSG_GNQ, "GNQ"},
-	{NMEA_MSG_GNS, "GNS"},
-	{NMEA_MSG_GPQ, "GPQ"},
-	{NMEA_MSG_GRS, "GRS"},
-	{NMEA_MSG_GSA, "GSA"}, // Has NMEA Parser
-	{NMEA_MSG_GST, "GST"}, // Has NMEA Parser
-	{NMEA_MSG_GSV, "GSV"}, // Has NMEA Parser
-	{NMEA_MSG_RMC, "RMC"}, // Has NMEA Parser
-	{NMEA_MSG_TXT, "TXT"},
-	{NMEA_MSG_VLW, "VLW"},
-	{NMEA_MSG_VTG, "VTG"}, // Has NMEA Parser
-	{NMEA_MSG_ZDA, "ZDA"}, // Has NMEA Parser
+static const NMEA_Identifer_t PayloadID_Data[1 << NMEA_PAYLOAD_HASH_BITS] = {
+	NMEA_PAYLOAD_SLOT('D', 'T', 'M', NMEA_MSG_DTM), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('G', 'B', 'Q', NMEA_MSG_GBQ),
+	NMEA_PAYLOAD_SLOT('G', 'B', 'S', NMEA_MSG_GBS), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('G', 'G', 'A', NMEA_MSG_GGA), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('G', 'L', 'L', NMEA_MSG_GLL), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('G', 'L', 'Q', NMEA_MSG_GLQ),
+	NMEA_PAYLOAD_SLOT('G', 'N', 'Q', NMEA_MSG_GNQ),
+	NMEA_PAYLOAD_SLOT('G', 'N', 'S', NMEA_MSG_GNS), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('G', 'P', 'Q', NMEA_MSG_GPQ),
+	NMEA_PAYLOAD_SLOT('G', 'R', 'S', NMEA_MSG_GRS), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('G', 'S', 'A', NMEA_MSG_GSA), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('G', 'S', 'T', NMEA_MSG_GST), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('G', 'S', 'V', NMEA_MSG_GSV), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('R', 'M', 'C', NMEA_MSG_RMC), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('T', 'X', 'T', NMEA_MSG_TXT), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('V', 'L', 'W', NMEA_MSG_VLW), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('V', 'T', 'G', NMEA_MSG_VTG), // Has NMEA Parser
+	NMEA_PAYLOAD_SLOT('Z', 'D', 'A', NMEA_MSG_ZDA), // Has NMEA Parser
 };
 
-static const PayloadID_Size = ARRAY_SIZE(PayloadID_Data);
-static const TalkerID_Size = ARRAY_SIZE(TalkerID_Data);
+static inline uint8_t NMEA_Talker_Lookup(uint32_t key) {
+	const NMEA_Identifer_t* slot = &TalkerID_Data[NMEA_TALKER_HASH(key)];
+	return (slot->key == key) ? slot->id_index : 0;
+}
+
+static inline uint8_t NMEA_Payload_Lookup(uint32_t key) {
+	const NMEA_Identifer_t* slot = &PayloadID_Data[NMEA_PAYLOAD_HASH(key)];
+	return (slot->key == key) ? slot->id_index : 0;
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
-static char* main_cursor;
-static uint16_t main_index;
+void NMEA_Parser_Init(NMEA_Parser_t* ctx) {
+	memset(ctx, 0, sizeof(NMEA_Parser_t));
+}
 
-static char talkerid[2];
-static char payloadid[3];
+static int8_t NMEA_HexDigit(uint8_t c) {
+	if (c >= '0' && c <= '9') return (int8_t)(c - '0');
+	if (c >= 'A' && c <= 'F') return (int8_t)(c - 'A' + 10);
+	if (c >= 'a' && c <= 'f') return (int8_t)(c - 'a' + 10);
+	return -1;
+}
 
-bool NMEA_Pack(NMEA_Message_t* ref, const uint8_t* raw) {
+/**
+* Fills the message reference of an already delimited sentence.
+* @param length = Sentence length, '$' to the checksum trailer.
+* @param valid = Checksum trailer matched the payload XOR.
+*/
+static bool NMEA_Parser_Accept(NMEA_Parser_t* ctx, NMEA_Message_t* ref, const uint8_t* raw, uint8_t length, bool valid) {
 
-	if (*raw != '$') return false;
+	if ((ctx->flags & NMEA_PARSER_CHECKSUM) && !valid) {
+		ctx->checksumErrors++;
+		ctx->rejected++;
+		return false;
+	}
+
+	ref->rawdata = (uint8_t*)raw;
 
-	main_index = 1;
-	uint8_t i;
+	uint8_t address_end = NMEA_TALKER_ID_LEN + NMEA_PAYLOAD_ID_LEN + 1;
 
-	for (i = 0; i < NMEA_TALKER_ID_LEN; i++) {
-		talkerid[i] = raw[main_index];
-		main_index++;
+	if (length >= address_end && raw[1] != 'P' && (length == address_end || raw[address_end] == ',' || raw[address_end] == '*')) {
+		/* Standard address: talker & payload ID are resolved from the 5 address bytes. */
+		uint32_t address = NMEA_ID2(raw[1], raw[2]) | (NMEA_ID2(raw[3], raw[4]) << 16);
+		ref->talkerId = NMEA_Talker_Lookup(address & 0xFFFF);
+		ref->payloadId = NMEA_Payload_Lookup((address >> 16) | ((uint32_t)raw[5] << 16));
+		ref->payload = (uint8_t*)&raw[address_end];
 	}
+	else {
+		/* Proprietary '$P' or malformed address, payload starts after the address field. */
+		uint16_t index = 1;
+		while (index < length && raw[index] != ',' && raw[index] != '*') index++;
+
+		ref->talkerId = (raw[1] == 'P') ? NMEA_TALKER_P : 0;
+		ref->payloadId = 0;
+		ref->payload = (uint8_t*)&raw[index];
+	}
+	ref->length = length;
+
+	ctx->packed++;
+	return true;
+}
+
+bool NMEA_Parser_Pack(NMEA_Parser_t* ctx, NMEA_Message_t* ref, const uint8_t* raw) {
 
-	for (i = 0; i < NMEA_PAYLOAD_ID_LEN; i++) {
-		payloadid[i] = raw[main_index];
-		main_index++;
+	if (*raw != '$') {
+		ctx->rejected++;
+		return false;
 	}
 
+	/* One walk finds the sentence end and XORs the payload on the way. */
+	uint8_t checksum = 0x00;
+	uint16_t index = 1;
 
-	ref->rawdata = (uint8_t*)raw;
-	ref->talkerId = NMEA_Find_TalkerID(talkerid);
-	ref->payloadId = NMEA_Find_PayloadID(payloadid);
-	ref->payload = (uint8_t*)&raw[main_index];
+	while (raw[index] && raw[index] != '*' && raw[index] != '\r' && raw[index] != '\n') {
+		checksum ^= raw[index];
+		if (++index > UINT8_MAX - 3) {
+			ctx->rejected++;
+			return false;
+		}
+	}
 
-	return true;
+	bool valid = false;
+
+	if (raw[index] == '*') {
+		int8_t high = NMEA_HexDigit(raw[index + 1]);
+		int8_t low = (high < 0) ? -1 : NMEA_HexDigit(raw[index + 2]);
+
+		if (low >= 0) {
+			valid = (uint8_t)((high << 4) | low) == checksum;
+			index += 3;
+		}
+	}
+
+	return NMEA_Parser_Accept(ctx, ref, raw, (uint8_t)index, valid);
+}
+
+void NMEA_Parser_SetCallback(NMEA_Parser_t* ctx, NMEA_Callback_t callback, void* user) {
+	ctx->callback = callback;
+	ctx->user = user;
+}
+
+static void NMEA_Frame_Emit(NMEA_Parser_t* ctx) {
+	NMEA_Message_t msg;
+
+	/* Checksum was accumulated while the line was collected. */
+	bool valid = (ctx->state == NMEA_FRAME_CHECKSUM) && (ctx->digits == 2) && (ctx->trailer == ctx->checksum);
+
+	ctx->line[ctx->length] = '\0';
+	ctx->state = NMEA_FRAME_IDLE;
+
+	if (!NMEA_Parser_Accept(ctx, &msg, ctx->line, ctx->length, valid)) return;
+	if (ctx->callback) ctx->callback(&msg, ctx->user);
+}
+
+uint32_t NMEA_Feed(NMEA_Parser_t* ctx, const uint8_t* buf, size_t len) {
+
+	const uint8_t* end = buf + len;
+	uint32_t emitted = 0;
+
+	while (buf < end) {
+
+		if (ctx->state == NMEA_FRAME_IDLE) {
+			/* Skip garbage up to the next start symbol in one sweep. */
+			const uint8_t* start = memchr(buf, '$', (size_t)(end - buf));
+			if (start == NULL) break;
+
+			ctx->line[0] = '$';
+			ctx->length = 1;
+			ctx->checksum = 0x00;
+			ctx->state = NMEA_FRAME_BODY;
+			buf = start + 1;
+			continue;
+		}
+
+		uint8_t c = *buf++;
+
+		if (c == '\r' || c == '\n') {
+			uint32_t packed = ctx->packed;
+			NMEA_Frame_Emit(ctx);
+			emitted += ctx->packed - packed;
+			continue;
+		}
+
+		if (c == '$') {		// Resync, previous sentence was cut.
+			ctx->length = 1;
+			ctx->checksum = 0x00;
+			ctx->state = NMEA_FRAME_BODY;
+			continue;
+		}
+
+		if (ctx->length >= NMEA_MAX_MESSAGE_LEN) {
+			ctx->overflows++;
+			ctx->state = NMEA_FRAME_IDLE;
+			continue;
+		}
+
+		ctx->line[ctx->length++] = c;
+
+		if (ctx->state == NMEA_FRAME_BODY) {
+			if (c == '*') {
+				ctx->state = NMEA_FRAME_CHECKSUM;
+				ctx->trailer = 0x00;
+				ctx->digits = 0;
+			}
+			else ctx->checksum ^= c;
+		}
+		else {
+			/* A bad digit marks the trailer invalid for the rest of the line. */
+			int8_t digit = NMEA_HexDigit(c);
+			ctx->trailer = (uint8_t)((ctx->trailer << 4) | (uint8_t)digit);
+			if (digit < 0) ctx->digits = UINT8_MAX;
+			else if (ctx->digits != UINT8_MAX) ctx->digits++;
+		}
+	}
+
+	return emitted;
 }
 
-uint8_t NMEA_Checksum(const char* msg)
-{
+bool NMEA_Pack(NMEA_Message_t* ref, const uint8_t* raw) {
+	NMEA_Parser_t ctx;
+	NMEA_Parser_Init(&ctx);
+	return NMEA_Parser_Pack(&ctx, ref, raw);
+}
+
+uint8_t NMEA_Checksum(const char* msg) {
 	/* Support senteces with or without the starting dollar sign. */
 	if (*msg == '$') msg++;
 
@@ -130,49 +330,417 @@ uint8_t NMEA_Checksum(const char* msg)
 }
 
 uint8_t NMEA_Find_TalkerID(const char* msg) {
-	
-	for (uint8_t i = 0; i < TalkerID_Size; i++) {
-		if (strcmp(msg, TalkerID_Data[i].id) == 0) {
-			return TalkerID_Data[i].id_index;
-		}
-	}
-	return 0;
+	return NMEA_Talker_Lookup(NMEA_ID2(msg[0], msg[1]));
 }
 
 uint8_t NMEA_Find_PayloadID(const char* msg) {
-	
-	for (uint8_t i = 0; i < PayloadID_Size; i++) {
-		if (strcmp(msg, PayloadID_Data[i].id) == 0) {
-			return PayloadID_Data[i].id_index;
+	return NMEA_Payload_Lookup(NMEA_ID3(msg[0], msg[1], msg[2]));
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+*  Field Index
+*  One sweep over the payload marks every ',' separator and the closing '*'.
+*  Vector kernels compare 16/32 bytes at a time and return a bit per byte,
+*  runtime dispatched on x86, compile time on ARM, scalar everywhere else.
+*/
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define NMEA_SIMD_SSE2
+#include <emmintrin.h>
+#if (defined(__GNUC__) && __GNUC__ >= 5) || defined(__clang__)
+#define NMEA_SIMD_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define NMEA_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+static inline uint8_t NMEA_Ctz64(uint64_t v) {
+#if defined(__GNUC__)
+	return (uint8_t)__builtin_ctzll(v);
+#else
+	uint8_t n = 0;
+	while (!(v & 1)) { v >>= 1; n++; }
+	return n;
+#endif
+}
+
+static uint64_t NMEA_SepMask_Scalar(const uint8_t* p, uint8_t n) {
+	uint64_t mask = 0;
+	for (uint8_t i = 0; i < n; i++) {
+		if (p[i] == ',' || p[i] == '*') mask |= (uint64_t)1 << i;
+	}
+	return mask;
+}
+
+#if defined(NMEA_SIMD_SSE2)
+static uint64_t NMEA_SepMask_SSE2(const uint8_t* p, uint8_t n) {
+	const __m128i comma = _mm_set1_epi8(',');
+	const __m128i star = _mm_set1_epi8('*');
+	uint64_t mask = 0;
+	uint8_t i = 0;
+
+	for (; i + 16 <= n; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)&p[i]);
+		__m128i eq = _mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, star));
+		mask |= (uint64_t)(uint32_t)_mm_movemask_epi8(eq) << i;
+	}
+	return mask | (NMEA_SepMask_Scalar(&p[i], n - i) << i);
+}
+#endif
+
+#if defined(NMEA_SIMD_AVX2)
+__attribute__((target("avx2")))
+static uint64_t NMEA_SepMask_AVX2(const uint8_t* p, uint8_t n) {
+	const __m256i comma = _mm256_set1_epi8(',');
+	const __m256i star = _mm256_set1_epi8('*');
+	uint64_t mask = 0;
+	uint8_t i = 0;
+
+	for (; i + 32 <= n; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)&p[i]);
+		__m256i eq = _mm256_or_si256(_mm256_cmpeq_epi8(v, comma), _mm256_cmpeq_epi8(v, star));
+		mask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(eq) << i;
+	}
+	_mm256_zeroupper();		// Tail runs legacy SSE code, avoid the transition penalty.
+	return mask | (NMEA_SepMask_SSE2(&p[i], n - i) << i);
+}
+#endif
+
+#if defined(NMEA_SIMD_NEON)
+static uint64_t NMEA_SepMask_NEON(const uint8_t* p, uint8_t n) {
+	static const uint8_t weight[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	const uint8x16_t bits = vld1q_u8(weight);
+	uint64_t mask = 0;
+	uint8_t i = 0;
+
+	for (; i + 16 <= n; i += 16) {
+		uint8x16_t v = vld1q_u8(&p[i]);
+		uint8x16_t eq = vandq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8(',')), vceqq_u8(v, vdupq_n_u8('*'))), bits);
+		uint64_t m = (uint64_t)vaddv_u8(vget_low_u8(eq)) | ((uint64_t)vaddv_u8(vget_high_u8(eq)) << 8);
+		mask |= m << i;
+	}
+	return mask | (NMEA_SepMask_Scalar(&p[i], n - i) << i);
+}
+#endif
+
+#if defined(NMEA_SIMD_AVX2)
+/* CPU check once at load time instead of per chunk. Written before main, read only after: no parsing state. */
+static uint64_t (*NMEA_SepMask_X86)(const uint8_t* p, uint8_t n) = NMEA_SepMask_SSE2;
+
+__attribute__((constructor))
+static void NMEA_SepMask_Resolve(void) {
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) NMEA_SepMask_X86 = NMEA_SepMask_AVX2;
+}
+#endif
+
+/* Separator bit mask of up to 64 bytes. */
+static inline uint64_t NMEA_SepMask(const uint8_t* p, uint8_t n) {
+#if defined(NMEA_SIMD_AVX2)
+	return NMEA_SepMask_X86(p, n);
+#elif defined(NMEA_SIMD_SSE2)
+	return NMEA_SepMask_SSE2(p, n);
+#elif defined(NMEA_SIMD_NEON)
+	return NMEA_SepMask_NEON(p, n);
+#else
+	return NMEA_SepMask_Scalar(p, n);
+#endif
+}
+
+uint8_t NMEA_Index(NMEA_Fields_t* fields, const NMEA_Message_t* msg) {
+
+	const uint8_t* payload = msg->payload;
+	uint16_t size = 0;
+	uint8_t count = 0;
+
+	if (msg->length) size = (uint16_t)(msg->rawdata + msg->length - payload);
+	else while (payload[size] && payload[size] != '*' && payload[size] != '\r' && payload[size] != '\n') size++;
+
+	for (uint16_t base = 0; base < size; base += 64) {
+		uint8_t chunk = (size - base < 64) ? (uint8_t)(size - base) : 64;
+		uint64_t mask = NMEA_SepMask(&payload[base], chunk);
+
+		while (mask) {
+			uint16_t pos = base + NMEA_Ctz64(mask);
+			mask &= mask - 1;
+
+			if (payload[pos] == '*' || count == NMEA_MAX_FIELDS) {
+				size = pos;
+				goto index_end;
+			}
+			fields->offset[count++] = (uint8_t)pos;
 		}
 	}
-	return 0;
+
+index_end:
+	fields->offset[count] = (uint8_t)size;
+	fields->count = count;
+	return count;
 }
 
+const char* NMEA_Field(const NMEA_Message_t* msg, const NMEA_Fields_t* fields, uint8_t n) {
+	if (n >= fields->count) return NULL;
+	return (const char*)&msg->payload[fields->offset[n] + 1];
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#define FIELD_CONTROL(cursor) (cursor == ',' || cursor == '*')
+
+#define DIGIT_CONTROL(val) (val>='0' && val<='9')
+
+#define NMEA_MAX_DECIMAL_DIGITS		15		// Significant digits kept, 10^15 < 2^53
+#define NMEA_MAX_POW10				22		// Largest power of ten exact in a double
+
+static const double NMEA_Pow10[NMEA_MAX_POW10 + 1] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+	1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+	1e20, 1e21, 1e22,
+};
+
+/**
+* Signed decimal integer, stops at the first non digit like strtol(.., 10).
+* Saturates at INT32_MIN / INT32_MAX.
+* Returns the pointer after the last consumed character.
+*/
+static const char* NMEA_ParseInteger(const char* p, int32_t* value) {
+	bool negative = (*p == '-');
+	if (negative || *p == '+') p++;
+
+	uint32_t limit = negative ? (uint32_t)INT32_MAX + 1 : (uint32_t)INT32_MAX;
+	uint32_t v = 0;
+	while (DIGIT_CONTROL(*p)) {
+		uint32_t digit = (uint32_t)(*p - '0');
+		v = (v > (limit - digit) / 10) ? limit : v * 10 + digit;
+		p++;
+	}
+
+	*value = negative ? (int32_t)(0 - v) : (int32_t)v;
+	return p;
+}
+
 /**
-* Carries main_cursor to the next ',' value of field.
-* @param main_index = Counts move iterations.
-* Returns 1 if there is a field.
-* Returns 0 if found <message end symbol> or <field len overflow>.
+* Signed fractional number as a scaled integer: value = mantissa / 10^scale.
+* Integer and fraction digits are collected in one walk. Leading zeros aren't
+* counted, digits past NMEA_MAX_DECIMAL_DIGITS significant ones are dropped;
+* dropped integer digits make scale negative. Locale independent.
+* Returns the pointer after the last consumed character.
 */
-bool NMEA_NextField(const char* msg) {
-	for (main_index = 1; main_index < NMEA_MAX_FIELD_LEN; main_index++) {
-		if (msg[main_index] == ',') {
-			main_cursor = (char*)&msg[main_index];
-			return true;
+static const char* NMEA_ParseDecimal(const char* p, int64_t* mantissa, int16_t* scale) {
+	bool negative = (*p == '-');
+	if (negative || *p == '+') p++;
+
+	uint64_t v = 0;
+	uint8_t digits = 0;
+	int16_t exponent = 0;
+
+	while (DIGIT_CONTROL(*p)) {
+		if (digits < NMEA_MAX_DECIMAL_DIGITS) {
+			v = v * 10 + (uint64_t)(*p - '0');
+			if (v) digits++;
 		}
-		if (msg[main_index] == '*') {
-			main_cursor = (char*)&msg[main_index];
-			return false;
+		else exponent--;
+		p++;
+	}
+
+	if (*p == '.') {
+		p++;
+		while (DIGIT_CONTROL(*p)) {
+			if (digits < NMEA_MAX_DECIMAL_DIGITS) {
+				v = v * 10 + (uint64_t)(*p - '0');
+				if (v) digits++;
+				exponent++;
+			}
+			p++;
 		}
 	}
-	return false;
+
+	*mantissa = negative ? -(int64_t)v : (int64_t)v;
+	*scale = exponent;
+	return p;
+}
+
+/**
+* Mantissa is exact in a double below 2^53 and so is every power of ten up to
+* 10^22, so the single division or multiplication rounds correctly, same as
+* strtod, for up to NMEA_MAX_DECIMAL_DIGITS significant digits.
+*/
+static double NMEA_ParseDouble(const char* p) {
+	int64_t mantissa;
+	int16_t scale;
+	NMEA_ParseDecimal(p, &mantissa, &scale);
+
+	double value = (double)mantissa;
+	if (scale >= 0) {
+		for (; scale > NMEA_MAX_POW10; scale -= NMEA_MAX_POW10) value /= NMEA_Pow10[NMEA_MAX_POW10];
+		return value / NMEA_Pow10[scale];
+	}
+
+	for (; scale < -NMEA_MAX_POW10; scale += NMEA_MAX_POW10) value *= NMEA_Pow10[NMEA_MAX_POW10];
+	return value * NMEA_Pow10[-scale];
+}
+
+/* Two digit group of time / date fields. Stops at the first non digit like strtol. */
+static int8_t NMEA_ParseDigits2(const char* p) {
+	if (!DIGIT_CONTROL(p[0])) return 0;
+	if (!DIGIT_CONTROL(p[1])) return (int8_t)(p[0] - '0');
+	return (int8_t)((p[0] - '0') * 10 + (p[1] - '0'));
+}
+
+/*
+*  Field Decoders
+*  One decoder per NMEA_Scan format character. Cursor points the ',' before
+*  the field, cursor[1] is the first field character. Return 0 on a malformed
+*  field. Shared by NMEA_Scan and the specialized per-type parsers.
+*/
+#define NMEA_FIELD_LEN(fields, n)	((uint8_t)((fields).offset[(n) + 1] - (fields).offset[(n)] - 1))
+
+#define NUMBER_CONTROL(cursor)	(DIGIT_CONTROL(cursor) || cursor == '-')
+
+static inline bool NMEA_Field_Char(const char* cursor, char* out) {
+	*out = FIELD_CONTROL(cursor[1]) ? ' ' : cursor[1];
+	return true;
+}
+
+static inline bool NMEA_Field_Int(const char* cursor, int32_t* out) {
+	if (FIELD_CONTROL(cursor[1])) {
+		*out = 0;
+		return true;
+	}
+	if (!NUMBER_CONTROL(cursor[1])) return false;
+
+	NMEA_ParseInteger(&cursor[1], out);
+	return true;
+}
+
+static inline bool NMEA_Field_Uint(const char* cursor, uint32_t* out) {
+	int32_t val = 0;
+	if (!NMEA_Field_Int(cursor, &val)) return false;
+	*out = (uint32_t)val;
+	return true;
+}
+
+static inline bool NMEA_Field_Byte(const char* cursor, uint8_t* out) {
+	int32_t val = 0;
+	if (!NMEA_Field_Int(cursor, &val)) return false;
+	*out = (uint8_t)val;
+	return true;
+}
+
+static inline bool NMEA_Field_Double(const char* cursor, double* out) {
+	if (FIELD_CONTROL(cursor[1])) {
+		*out = 0;
+		return true;
+	}
+	if (!NUMBER_CONTROL(cursor[1])) return false;
+
+	*out = NMEA_ParseDouble(&cursor[1]);
+	return true;
+}
+
+static inline bool NMEA_Field_Float(const char* cursor, float* out) {
+	double val = 0;
+	if (!NMEA_Field_Double(cursor, &val)) return false;
+	*out = (float)val;
+	return true;
 }
 
+static inline bool NMEA_Field_String(const char* cursor, uint8_t len, char* out) {
+	memcpy(out, &cursor[1], len);
+	return true;
+}
 
+/* Bounded copy, truncated to size - 1 characters & NUL terminated. */
+static inline bool NMEA_Field_Text(const char* cursor, uint8_t len, char* out, uint8_t size) {
+	if (len >= size) len = size - 1;
+	memcpy(out, &cursor[1], len);
+	out[len] = '\0';
+	return true;
+}
+
+static inline bool NMEA_Field_Direction(const char* cursor, int8_t* out) {
+	switch (cursor[1]) {
+	case ',':
+	case '*': *out = 0; return true;
+	case 'N':
+	case 'E': *out = 1; return true;
+	case 'S':
+	case 'W': *out = -1; return true;
+	default: return false;
+	}
+}
+
+static inline bool NMEA_Field_Date(const char* cursor, NMEA_Date_t* date_) {
+	if (FIELD_CONTROL(cursor[1])) {
+		date_->year = -1;
+		date_->month = -1;
+		date_->day = -1;
+		return true;
+	}
+
+	date_->day = NMEA_ParseDigits2(&cursor[1]);
+	date_->month = NMEA_ParseDigits2(&cursor[3]);
+	date_->year = NMEA_ParseDigits2(&cursor[5]) + 2000;
+	return true;
+}
+
+static inline bool NMEA_Field_Time(const char* cursor, NMEA_Time_t* time_) {
+	if (FIELD_CONTROL(cursor[1])) {
+		time_->hour = -1;
+		time_->min = -1;
+		time_->sec = -1;
+		time_->ms = -1;
+		return true;
+	}
+
+	time_->hour = NMEA_ParseDigits2(&cursor[1]);
+	time_->min = NMEA_ParseDigits2(&cursor[3]);
+	time_->sec = NMEA_ParseDigits2(&cursor[5]);
+
+	/* hhmmss.sss, fraction digits past milliseconds are dropped. */
+	int32_t ms = 0;
+	int32_t unit = 100;
+	if (DIGIT_CONTROL(cursor[6]) && cursor[7] == '.') {
+		for (const char* p = &cursor[8]; DIGIT_CONTROL(*p) && unit; p++, unit /= 10) ms += (*p - '0') * unit;
+	}
+	time_->ms = ((time_->hour * 60 + time_->min) * 60 + time_->sec) * 1000 + ms;
+	return true;
+}
+
+static inline bool NMEA_Field_Location(const char* cursor, int32_t* out) {
+	if (FIELD_CONTROL(cursor[1])) {
+		*out = -1;
+		return true;
+	}
+	if (!NUMBER_CONTROL(cursor[1])) return false;
+
+	int64_t mantissa;
+	int16_t scale;
+
+	/* dddmm.mmmm..., any number of minute digits. Rounded once, to nearest. */
+	NMEA_ParseDecimal(&cursor[1], &mantissa, &scale);
+	if (scale < 0) return false;
+
+	bool negative = (mantissa < 0);
+	uint64_t v = negative ? (uint64_t)-mantissa : (uint64_t)mantissa;
+
+	/* Keeps minutes * 1e7 in 64 bits, 1e-9 minute is far below the 1e-7 degree unit. */
+	while (scale > 9) { v = (v + 5) / 10; scale--; }
+
+	uint64_t unit = 1;
+	for (uint8_t i = 0; i < scale; i++) unit *= 10;
+	uint64_t degrees = v / (100 * unit);
+	uint64_t minutes = v % (100 * unit);
+	uint64_t fraction = (minutes * 10000000 + 30 * unit) / (60 * unit);
+
+	int32_t value = (int32_t)(degrees * 10000000 + fraction);
+	*out = negative ? -value : value;
+	return true;
+}
 
 /**
  * Scanf-like processor for NMEA sentences. Supports the following formats:
@@ -190,416 +758,650 @@ bool NMEA_NextField(const char* msg) {
  * Returns true on success. See library source code for details.
  */
 uint8_t NMEA_Scan(const NMEA_Message_t* msg, const char* format, ...) {
-
-	if (msg->payload == NULL) return 0;
-
-	uint8_t result = 0;
-
-	main_cursor = (char*)msg->payload;				// main_cursor[0] points the first ',' element of payload section.
-
 	va_list payload;
 	va_start(payload, format);
+	uint8_t result = NMEA_VScan(msg, format, payload);
+	va_end(payload);
+	return result;
+}
 
-#define FIELD_CONTROL(cursor) (cursor == ',' || cursor == '*')
+/**
+ * va_list version of NMEA_Scan. The scan cursor lives on the caller stack,
+ * so any number of threads may scan independent messages at once.
+ */
+uint8_t NMEA_VScan(const NMEA_Message_t* msg, const char* format, va_list payload) {
 
-#define DIGIT_CONTROL(val) (val>='0' && val<='9')
+	if (msg->payload == NULL) return 0;
 
-	while (*format) {
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	for (uint8_t field = 0; *format && field < fields.count; field++) {
 		char type = *format++;				// Get the current format char. && Post increment.
 
+		// main_cursor[0] points the ',' before the field, jumped straight from the index.
+		const char* main_cursor = (const char*)&msg->payload[fields.offset[field]];
+		bool ok = true;
+
 		switch (type)
 		{
-		case 'c': /* char */ {
-			if (FIELD_CONTROL(main_cursor[1])) {
-				*va_arg(payload, char*) = ' ';
-				break;
-			}
-			*va_arg(payload, char*) = main_cursor[1];
-		} break;
-
-		case 'd': { /* int32_t */
-			if (FIELD_CONTROL(main_cursor[1])) {
-				*va_arg(payload, int32_t*) = 0;
-				break;
-			}
-			if (!(DIGIT_CONTROL(main_cursor[1]) || main_cursor[1] == '-')) goto parse_error;
-
-			char* ptr;
-			*va_arg(payload, int32_t*) = strtol(&main_cursor[1], &ptr, 10);
-		} break;
+		case 'c': ok = NMEA_Field_Char(main_cursor, va_arg(payload, char*)); break;
+		case 'd': ok = NMEA_Field_Int(main_cursor, va_arg(payload, int32_t*)); break;
+		case 'f': ok = NMEA_Field_Float(main_cursor, va_arg(payload, float*)); break;
+		case 'u': ok = NMEA_Field_Uint(main_cursor, va_arg(payload, uint32_t*)); break;
+		case 'i': ok = NMEA_Field_Byte(main_cursor, va_arg(payload, uint8_t*)); break;
+		case 's': ok = NMEA_Field_String(main_cursor, NMEA_FIELD_LEN(fields, field), va_arg(payload, char*)); break;
+		case 'q': ok = NMEA_Field_Direction(main_cursor, va_arg(payload, int8_t*)); break;
+		case 'D': ok = NMEA_Field_Date(main_cursor, va_arg(payload, NMEA_Date_t*)); break;
+		case 'T': ok = NMEA_Field_Time(main_cursor, va_arg(payload, NMEA_Time_t*)); break;
+		case 'L': ok = NMEA_Field_Location(main_cursor, va_arg(payload, int32_t*)); break;
+		case 'F': ok = NMEA_Field_Double(main_cursor, va_arg(payload, double*)); break;
+		case '_': /* Ignore Field */ break;
+		default: /* Unknown */ ok = false; break;
+		} /* SWITCH_CASE */
 
-		case 'f': { /* double */
-			if (FIELD_CONTROL(main_cursor[1])) {
-				*va_arg(payload, float*) = 0;
-				break;
-			}
-			if (!(DIGIT_CONTROL(main_cursor[1]) || main_cursor[1] == '-')) goto parse_error;
+		if (!ok) return 0;
+	}
 
-			char* ptr;
-			*va_arg(payload, float*) = strtod(&main_cursor[1], &ptr);
-		} break;
+	return 1;
+}
 
-		case ('u'): { /* uint32_t */
-			if (FIELD_CONTROL(main_cursor[1])) {
-				*va_arg(payload, uint32_t*) = 0;
-				break;
-			}
-			if (!(DIGIT_CONTROL(main_cursor[1]) || main_cursor[1] == '-')) goto parse_error;
 
-			char* ptr;
-			*va_arg(payload, uint32_t*) = (uint32_t)strtol(&main_cursor[1], &ptr, 10);
-		} break;
+/*
+*  Lazy view. value[n] is valid when bit n of cached is set and kind[n] matches
+*  the accessor; a read with another type decodes again and replaces the cache.
+*/
+typedef enum {
+	NMEA_VIEW_INT = 1,
+	NMEA_VIEW_DOUBLE,
+	NMEA_VIEW_CHAR,
+	NMEA_VIEW_TIME,
+	NMEA_VIEW_DATE,		// Packed yyyymmdd, -1 if empty
+	NMEA_VIEW_LOCATION,
+}NMEA_viewKind_e;
+
+void NMEA_View_Init(NMEA_View_t* view, const NMEA_Message_t* msg) {
+	view->msg = msg;
+	view->cached = 0;
+	view->fields.count = 0;
+	if (msg->payload) NMEA_Index(&view->fields, msg);
+}
 
-		case ('i'): { /* uint8_t */
-			if (FIELD_CONTROL(main_cursor[1])) {
-				*va_arg(payload, uint8_t*) = 0;
-				break;
-			}
+/* Cursor of field n, NULL if missing. Sets *hit when the cache holds the kind. */
+static inline const char* NMEA_View_Lookup(NMEA_View_t* view, uint8_t n, uint8_t kind, bool* hit) {
+	if (n >= view->fields.count) return NULL;
+	*hit = (view->cached & (1ull << n)) && view->kind[n] == kind;
+	return (const char*)&view->msg->payload[view->fields.offset[n]];
+}
 
-			if (!(DIGIT_CONTROL(main_cursor[1]) || main_cursor[1] == '-')) goto parse_error;
+static inline void NMEA_View_Store(NMEA_View_t* view, uint8_t n, uint8_t kind) {
+	view->cached |= 1ull << n;
+	view->kind[n] = kind;
+}
 
-			char* ptr;
-			*va_arg(payload, uint8_t*) = (uint8_t)strtol(&main_cursor[1], &ptr, 10);
-		} break;
+bool NMEA_View_Int(NMEA_View_t* view, uint8_t n, int32_t* out) {
+	bool hit;
+	const char* cursor = NMEA_View_Lookup(view, n, NMEA_VIEW_INT, &hit);
+	if (!cursor) return false;
 
-		case 's': { /* string */
-			char* ptr = va_arg(payload, char*);
+	if (!hit) {
+		if (!NMEA_Field_Int(cursor, &view->value[n].i)) return false;
+		NMEA_View_Store(view, n, NMEA_VIEW_INT);
+	}
+	*out = view->value[n].i;
+	return true;
+}
 
-			uint8_t i = 1;
-			while (!FIELD_CONTROL(main_cursor[i])) {
-				*ptr++ = main_cursor[i];
-				i++;
-			}
-		} break;
+bool NMEA_View_Double(NMEA_View_t* view, uint8_t n, double* out) {
+	bool hit;
+	const char* cursor = NMEA_View_Lookup(view, n, NMEA_VIEW_DOUBLE, &hit);
+	if (!cursor) return false;
 
-		case 'q': { /* direction int8_t */
-			if (FIELD_CONTROL(main_cursor[1])) {
-				*va_arg(payload, int8_t*) = 0;
-				break;
-			}
-			int8_t direction = 0;
-
-			switch (main_cursor[1]) {
-			case 'N':
-			case 'E': {
-				direction = 1;
-			}break;
-			case 'S':
-			case 'W': {
-				direction = -1;
-			}break;
-
-			default: {
-				goto parse_error;
-			}break;
-			}
+	if (!hit) {
+		if (!NMEA_Field_Double(cursor, &view->value[n].f)) return false;
+		NMEA_View_Store(view, n, NMEA_VIEW_DOUBLE);
+	}
+	*out = view->value[n].f;
+	return true;
+}
 
-			*va_arg(payload, int8_t*) = direction;
+bool NMEA_View_Char(NMEA_View_t* view, uint8_t n, char* out) {
+	bool hit;
+	const char* cursor = NMEA_View_Lookup(view, n, NMEA_VIEW_CHAR, &hit);
+	if (!cursor) return false;
 
-		} break;
+	if (!hit) {
+		if (!NMEA_Field_Char(cursor, &view->value[n].c)) return false;
+		NMEA_View_Store(view, n, NMEA_VIEW_CHAR);
+	}
+	*out = view->value[n].c;
+	return true;
+}
 
-		case 'D': {
-			NMEA_Date_t* date_ = va_arg(payload, NMEA_Date_t*);
+bool NMEA_View_Time(NMEA_View_t* view, uint8_t n, NMEA_Time_t* out) {
+	bool hit;
+	const char* cursor = NMEA_View_Lookup(view, n, NMEA_VIEW_TIME, &hit);
+	if (!cursor) return false;
 
-			if (FIELD_CONTROL(main_cursor[1])) {
-				date_->year = -1;
-				date_->month = -1;
-				date_->day = -1;
-				break;
-			}
+	if (!hit) {
+		if (!NMEA_Field_Time(cursor, &view->value[n].t)) return false;
+		NMEA_View_Store(view, n, NMEA_VIEW_TIME);
+	}
+	*out = view->value[n].t;
+	return true;
+}
 
-			int16_t y = -1;
-			int8_t  m, d = -1;
+bool NMEA_View_Date(NMEA_View_t* view, uint8_t n, NMEA_Date_t* out) {
+	bool hit;
+	const char* cursor = NMEA_View_Lookup(view, n, NMEA_VIEW_DATE, &hit);
+	if (!cursor) return false;
+
+	if (hit) {
+		int32_t packed = view->value[n].i;
+		out->year = (packed < 0) ? -1 : packed / 10000;
+		out->month = (packed < 0) ? -1 : (packed / 100) % 100;
+		out->day = (packed < 0) ? -1 : packed % 100;
+		return true;
+	}
 
+	if (!NMEA_Field_Date(cursor, out)) return false;
+	view->value[n].i = (out->year < 0) ? -1 : out->year * 10000 + out->month * 100 + out->day;
+	NMEA_View_Store(view, n, NMEA_VIEW_DATE);
+	return true;
+}
 
-			char dArr[] = { main_cursor[1], main_cursor[2], '\0' };
-			char mArr[] = { main_cursor[3], main_cursor[4], '\0' };
-			char yArr[] = { main_cursor[5], main_cursor[6], '\0' };
+bool NMEA_View_Location(NMEA_View_t* view, uint8_t n, int32_t* out) {
+	bool hit;
+	const char* cursor = NMEA_View_Lookup(view, n, NMEA_VIEW_LOCATION, &hit);
+	if (!cursor || n + 1 >= view->fields.count) return false;
 
-			d = (int8_t)strtol(dArr, NULL, 10);
-			m = (int8_t)strtol(mArr, NULL, 10);
-			y = (int16_t)strtol(yArr, NULL, 10);
+	if (!hit) {
+		int32_t value;
+		int8_t direction;
+		if (!NMEA_Field_Location(cursor, &value)) return false;
+		if (!NMEA_Field_Direction((const char*)&view->msg->payload[view->fields.offset[n + 1]], &direction)) return false;
 
-			y += 2000;
+		view->value[n].i = (value >= 0 && direction < 0) ? -value : value;
+		NMEA_View_Store(view, n, NMEA_VIEW_LOCATION);
+	}
+	*out = view->value[n].i;
+	return true;
+}
 
-			date_->year = y;
-			date_->month = m;
-			date_->day = d;
 
-		} break;
-		case 'T': {
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-			NMEA_Time_t* time_ = va_arg(payload, NMEA_Time_t*);
+/*
+*  Parser jump table. Thunks adapt the typed parse functions to the union frame.
+*/
+#define NMEA_PARSE_THUNK(type, member) \
+	static uint8_t NMEA_Parse_##type(NMEA_Payload_t* frame, const NMEA_Message_t* msg) { \
+		return NMEA_##type##_Parse(&frame->member, msg); \
+	}
 
-			if (FIELD_CONTROL(main_cursor[1])) {
-				time_->hour = -1;
-				time_->min = -1;
-				time_->sec = -1;
-				break;
-			}
-			int8_t h, m, s = -1;
+NMEA_PARSE_THUNK(DTM, dtm)
+NMEA_PARSE_THUNK(GBS, gbs)
+NMEA_PARSE_THUNK(GGA, gga)
+NMEA_PARSE_THUNK(GLL, gll)
+NMEA_PARSE_THUNK(GNS, gns)
+NMEA_PARSE_THUNK(GRS, grs)
+NMEA_PARSE_THUNK(GSA, gsa)
+NMEA_PARSE_THUNK(GST, gst)
+NMEA_PARSE_THUNK(GSV, gsv)
+NMEA_PARSE_THUNK(RMC, rmc)
+NMEA_PARSE_THUNK(TXT, txt)
+NMEA_PARSE_THUNK(VLW, vlw)
+NMEA_PARSE_THUNK(VTG, vtg)
+NMEA_PARSE_THUNK(ZDA, zda)
+
+typedef uint8_t (*NMEA_ParseFunc_t)(NMEA_Payload_t* frame, const NMEA_Message_t* msg);
+
+static const NMEA_ParseFunc_t Parse_Table[NMEA_MSG_ZDA + 1] = {
+	[NMEA_MSG_DTM] = NMEA_Parse_DTM,
+	[NMEA_MSG_GBS] = NMEA_Parse_GBS,
+	[NMEA_MSG_GGA] = NMEA_Parse_GGA,
+	[NMEA_MSG_GLL] = NMEA_Parse_GLL,
+	[NMEA_MSG_GNS] = NMEA_Parse_GNS,
+	[NMEA_MSG_GRS] = NMEA_Parse_GRS,
+	[NMEA_MSG_GSA] = NMEA_Parse_GSA,
+	[NMEA_MSG_GST] = NMEA_Parse_GST,
+	[NMEA_MSG_GSV] = NMEA_Parse_GSV,
+	[NMEA_MSG_RMC] = NMEA_Parse_RMC,
+	[NMEA_MSG_TXT] = NMEA_Parse_TXT,
+	[NMEA_MSG_VLW] = NMEA_Parse_VLW,
+	[NMEA_MSG_VTG] = NMEA_Parse_VTG,
+	[NMEA_MSG_ZDA] = NMEA_Parse_ZDA,
+};
 
-			char hArr[] = { main_cursor[1], main_cursor[2], '\0' };
-			char mArr[] = { main_cursor[3], main_cursor[4], '\0' };
-			char sArr[] = { main_cursor[5], main_cursor[6], '\0' };
+uint8_t NMEA_Parse(NMEA_Payload_t* frame, const NMEA_Message_t* msg) {
+	if (msg->payloadId > NMEA_MSG_ZDA || !Parse_Table[msg->payloadId]) return 0;
+	return Parse_Table[msg->payloadId](frame, msg);
+}
 
-			h = (int8_t)strtol(hArr, NULL, 10);
-			m = (int8_t)strtol(mArr, NULL, 10);
-			s = (int8_t)strtol(sArr, NULL, 10);
+void NMEA_Handlers_Init(NMEA_Handlers_t* handlers) {
+	memset(handlers, 0, sizeof(NMEA_Handlers_t));
+}
 
-			time_->hour = h;
-			time_->min = m;
-			time_->sec = s;
+void NMEA_Handlers_Set(NMEA_Handlers_t* handlers, uint8_t payloadId, NMEA_PayloadHandler_t handler, void* user) {
+	if (payloadId > NMEA_MSG_ZDA) return;
+	handlers->handler[payloadId] = handler;
+	handlers->user[payloadId] = user;
+}
 
-		} break;
-		case 'L': { /* location int32_t */
-			if (FIELD_CONTROL(main_cursor[1])) {
-				*va_arg(payload,int32_t*) = -1;
-				break;
-			}
-			if (!(DIGIT_CONTROL(main_cursor[1]) || main_cursor[1] == '-')) goto parse_error;
-			
-			int32_t val, scl = 0;
-			int32_t temp = 0;
-			char* ptr;
-			val = strtol(&main_cursor[1], &ptr, 10);
-			scl = strtol(&ptr[1], &ptr, 10);
-
-			temp = (val / 100);
-			temp *= 100;
-
-			scl += (val - temp) * 100000;
-			scl *= 10;
-			scl /=6 ;
-			
-			temp *= 100000;
-			temp += scl;
-			*va_arg(payload, int32_t*) = temp;
-
-		} break;
-		case 'F': { /* double */
-			if (FIELD_CONTROL(main_cursor[1])) {
-				*va_arg(payload, double*) = 0;
-				break;
-			}
-			if (!(DIGIT_CONTROL(main_cursor[1]) || main_cursor[1] == '-')) goto parse_error;
-
-			char* ptr;
-			*va_arg(payload, double*) = strtod(&main_cursor[1], &ptr);
-		} break;
-		case '_': { /* Ignore Field */
-		}break;
-		default: { /* Unknown */
-			goto parse_error;
-		}break;
-		} /* SWITCH_CASE */
+uint8_t NMEA_Dispatch_Message(const NMEA_Handlers_t* handlers, const NMEA_Message_t* msg) {
+	if (msg->payloadId > NMEA_MSG_ZDA) return 0;
 
-		if (!NMEA_NextField(main_cursor)) {
-			if (main_cursor[0] == '*') result = 1;
-			break;
-		}
+	/* Unregistered: nothing converted. */
+	NMEA_PayloadHandler_t handler = handlers->handler[msg->payloadId];
+	if (!handler) return 0;
 
+	NMEA_ParseFunc_t parse = Parse_Table[msg->payloadId];
+	if (!parse) {
+		handler(msg, NULL, handlers->user[msg->payloadId]);
+		return 1;
 	}
 
-	result = 1;
+	NMEA_Payload_t frame;
+	if (!parse(&frame, msg)) return 0;
 
-parse_error:
-	va_end(payload);
-	return result;
+	handler(msg, &frame, handlers->user[msg->payloadId]);
+	return 1;
+}
 
+uint8_t NMEA_Dispatch(NMEA_Parser_t* ctx, const NMEA_Handlers_t* handlers, const uint8_t* raw) {
+	NMEA_Message_t msg;
+	if (!NMEA_Parser_Pack(ctx, &msg, raw)) return 0;
+	return NMEA_Dispatch_Message(handlers, &msg);
 }
 
+void NMEA_Dispatch_Callback(const NMEA_Message_t* msg, void* handlers) {
+	NMEA_Dispatch_Message((const NMEA_Handlers_t*)handlers, msg);
+}
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/*
+*  Specialized parsers. Every per-type parser indexes the payload once and runs
+*  its field decoders straight-line: no format string, no varargs. A field past
+*  the end of the sentence leaves its member untouched, same as NMEA_Scan.
+*/
+#define NMEA_DECODE(n, decoder, out) \
+	if ((n) < fields.count && !decoder((const char*)&msg->payload[fields.offset[(n)]], out)) return 0
+
+/* Projection: fields of members outside the mask are jumped over unconverted. */
+#define NMEA_DECODE_IF(member, n, decoder, out) \
+	if (mask & (member)) NMEA_DECODE(n, decoder, out)
+
+/* Character array members, bounded by the member size. */
+#define NMEA_DECODE_TEXT_IF(member, n, out) \
+	if ((mask & (member)) && (n) < fields.count) \
+		NMEA_Field_Text((const char*)&msg->payload[fields.offset[(n)]], NMEA_FIELD_LEN(fields, n), out, sizeof(out))
+
+/* DTM Datum reference.
+*/
+uint8_t NMEA_DTM_ParseMask(NMEA_Payload_DTM_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
+	if (msg->payloadId != NMEA_MSG_DTM) return 0;
+
+	//$GPDTM,W84,,0.0,N,0.0,E,0.0,W84*6F
+
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_TEXT_IF(NMEA_DTM_DATUM, 0, frame->datum);
+	NMEA_DECODE_TEXT_IF(NMEA_DTM_DATUM, 1, frame->subDatum);
+	NMEA_DECODE_IF(NMEA_DTM_OFFSET, 2, NMEA_Field_Float, &frame->latOffset);
+	NMEA_DECODE_IF(NMEA_DTM_OFFSET, 3, NMEA_Field_Direction, &frame->ns_d);
+	NMEA_DECODE_IF(NMEA_DTM_OFFSET, 4, NMEA_Field_Float, &frame->lonOffset);
+	NMEA_DECODE_IF(NMEA_DTM_OFFSET, 5, NMEA_Field_Direction, &frame->ew_d);
+	NMEA_DECODE_IF(NMEA_DTM_OFFSET, 6, NMEA_Field_Float, &frame->altOffset);
+	NMEA_DECODE_TEXT_IF(NMEA_DTM_REFDATUM, 7, frame->refDatum);
+	return 1;
+}
+
+uint8_t NMEA_DTM_Parse(NMEA_Payload_DTM_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_DTM_ParseMask(frame, msg, NMEA_DTM_ALL);
+}
 
 /* GBS GNSS satellite fault detection.
 */
-uint8_t NMEA_GBS_Parse(NMEA_Payload_GBS_t* frame, const NMEA_Message_t* msg) {
+uint8_t NMEA_GBS_ParseMask(NMEA_Payload_GBS_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
 	if (msg->payloadId != NMEA_MSG_GBS) return 0;
 
 	//$GPGBS,235503.00,1.6,1.4,3.2,,,,,,*40
 	//$GPGBS,235458.00,1.4,1.3,3.1,03,,-21.4,3.8,1,0*5B
 
-	return NMEA_Scan(msg, "Tfffdfff",
-		&frame->time,
-		&frame->errLat,
-		&frame->errLon,
-		&frame->errAlt,
-		&frame->svid,
-		&frame->prob,
-		&frame->bias,
-		&frame->stddev
-	);
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_GBS_TIME, 0, NMEA_Field_Time, &frame->time);
+	NMEA_DECODE_IF(NMEA_GBS_ERRLAT, 1, NMEA_Field_Float, &frame->errLat);
+	NMEA_DECODE_IF(NMEA_GBS_ERRLON, 2, NMEA_Field_Float, &frame->errLon);
+	NMEA_DECODE_IF(NMEA_GBS_ERRALT, 3, NMEA_Field_Float, &frame->errAlt);
+	NMEA_DECODE_IF(NMEA_GBS_SVID, 4, NMEA_Field_Int, &frame->svid);
+	NMEA_DECODE_IF(NMEA_GBS_PROB, 5, NMEA_Field_Float, &frame->prob);
+	NMEA_DECODE_IF(NMEA_GBS_BIAS, 6, NMEA_Field_Float, &frame->bias);
+	NMEA_DECODE_IF(NMEA_GBS_STDDEV, 7, NMEA_Field_Float, &frame->stddev);
+	return 1;
+}
+
+uint8_t NMEA_GBS_Parse(NMEA_Payload_GBS_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_GBS_ParseMask(frame, msg, NMEA_GBS_ALL);
 }
 
 /* GGA Global Positioning System Fix Data. Time, Position and fix related data
 *  for GNSS receiver.
 */
-uint8_t NMEA_GGA_Parse(NMEA_Payload_GGA_t* frame, const NMEA_Message_t* msg) {
+uint8_t NMEA_GGA_ParseMask(NMEA_Payload_GGA_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
 	if (msg->payloadId != NMEA_MSG_GGA) return 0;
 
 	//$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B
 
-	return NMEA_Scan(msg, "TLqLqii",
-		&frame->time,
-		&frame->location.latitude,
-		&frame->location.ns_d,
-		&frame->location.longitude,
-		&frame->location.ew_d,
-		&frame->quality,
-		&frame->satellite_n
-	);
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_GGA_TIME, 0, NMEA_Field_Time, &frame->time);
+	NMEA_DECODE_IF(NMEA_GGA_LOCATION, 1, NMEA_Field_Location, &frame->location.latitude);
+	NMEA_DECODE_IF(NMEA_GGA_LOCATION, 2, NMEA_Field_Direction, &frame->location.ns_d);
+	NMEA_DECODE_IF(NMEA_GGA_LOCATION, 3, NMEA_Field_Location, &frame->location.longitude);
+	NMEA_DECODE_IF(NMEA_GGA_LOCATION, 4, NMEA_Field_Direction, &frame->location.ew_d);
+	NMEA_DECODE_IF(NMEA_GGA_QUALITY, 5, NMEA_Field_Byte, &frame->quality);
+	NMEA_DECODE_IF(NMEA_GGA_SATELLITES, 6, NMEA_Field_Byte, &frame->satellite_n);
+	NMEA_DECODE_IF(NMEA_GGA_HDOP, 7, NMEA_Field_Float, &frame->hdop);
+	NMEA_DECODE_IF(NMEA_GGA_ALTITUDE, 8, NMEA_Field_Float, &frame->altitude);
+	NMEA_DECODE_IF(NMEA_GGA_SEPARATION, 10, NMEA_Field_Float, &frame->separation);
+	NMEA_DECODE_IF(NMEA_GGA_DIFF, 12, NMEA_Field_Float, &frame->diffAge);
+	NMEA_DECODE_IF(NMEA_GGA_DIFF, 13, NMEA_Field_Int, &frame->diffStation);
+	return 1;
+}
+
+uint8_t NMEA_GGA_Parse(NMEA_Payload_GGA_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_GGA_ParseMask(frame, msg, NMEA_GGA_ALL);
 }
 
 
 /* GLL Latitude and longitude, with time of position fix and status.
 */
-uint8_t NMEA_GLL_Parse(NMEA_Payload_GLL_t* frame, const NMEA_Message_t* msg) {
+uint8_t NMEA_GLL_ParseMask(NMEA_Payload_GLL_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
 	if (msg->payloadId != NMEA_MSG_GLL) return 0;
 
 	//$GPGLL,4717.11364,N,00833.91565,E,092321.00,A,A*60
 
-	return NMEA_Scan(msg, "LqLqTcc",
-		&frame->location.latitude,
-		&frame->location.ns_d,
-		&frame->location.longitude,
-		&frame->location.ew_d,
-		&frame->time,
-		&frame->status,
-		&frame->posMode
-	);
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_GLL_LOCATION, 0, NMEA_Field_Location, &frame->location.latitude);
+	NMEA_DECODE_IF(NMEA_GLL_LOCATION, 1, NMEA_Field_Direction, &frame->location.ns_d);
+	NMEA_DECODE_IF(NMEA_GLL_LOCATION, 2, NMEA_Field_Location, &frame->location.longitude);
+	NMEA_DECODE_IF(NMEA_GLL_LOCATION, 3, NMEA_Field_Direction, &frame->location.ew_d);
+	NMEA_DECODE_IF(NMEA_GLL_TIME, 4, NMEA_Field_Time, &frame->time);
+	NMEA_DECODE_IF(NMEA_GLL_STATUS, 5, NMEA_Field_Char, &frame->status);
+	NMEA_DECODE_IF(NMEA_GLL_POSMODE, 6, NMEA_Field_Char, &frame->posMode);
+	return 1;
+}
+
+uint8_t NMEA_GLL_Parse(NMEA_Payload_GLL_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_GLL_ParseMask(frame, msg, NMEA_GLL_ALL);
+}
+
+/* GNS GNSS fix data, position mode per constellation.
+*/
+uint8_t NMEA_GNS_ParseMask(NMEA_Payload_GNS_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
+	if (msg->payloadId != NMEA_MSG_GNS) return 0;
+
+	//$GNGNS,103600.01,5114.51176,N,00012.29380,W,ANNN,07,1.18,111.5,45.6,,,V*00
+
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_GNS_TIME, 0, NMEA_Field_Time, &frame->time);
+	NMEA_DECODE_IF(NMEA_GNS_LOCATION, 1, NMEA_Field_Location, &frame->location.latitude);
+	NMEA_DECODE_IF(NMEA_GNS_LOCATION, 2, NMEA_Field_Direction, &frame->location.ns_d);
+	NMEA_DECODE_IF(NMEA_GNS_LOCATION, 3, NMEA_Field_Location, &frame->location.longitude);
+	NMEA_DECODE_IF(NMEA_GNS_LOCATION, 4, NMEA_Field_Direction, &frame->location.ew_d);
+	NMEA_DECODE_TEXT_IF(NMEA_GNS_POSMODE, 5, frame->posMode);
+	NMEA_DECODE_IF(NMEA_GNS_NUMSV, 6, NMEA_Field_Byte, &frame->numSV);
+	NMEA_DECODE_IF(NMEA_GNS_HDOP, 7, NMEA_Field_Float, &frame->hdop);
+	NMEA_DECODE_IF(NMEA_GNS_ALTITUDE, 8, NMEA_Field_Float, &frame->altitude);
+	NMEA_DECODE_IF(NMEA_GNS_SEPARATION, 9, NMEA_Field_Float, &frame->separation);
+	NMEA_DECODE_IF(NMEA_GNS_DIFF, 10, NMEA_Field_Float, &frame->diffAge);
+	NMEA_DECODE_IF(NMEA_GNS_DIFF, 11, NMEA_Field_Int, &frame->diffStation);
+	NMEA_DECODE_IF(NMEA_GNS_NAVSTATUS, 12, NMEA_Field_Char, &frame->navStatus);
+	return 1;
+}
+
+uint8_t NMEA_GNS_Parse(NMEA_Payload_GNS_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_GNS_ParseMask(frame, msg, NMEA_GNS_ALL);
+}
+
+/* GRS GNSS range residuals.
+*/
+uint8_t NMEA_GRS_ParseMask(NMEA_Payload_GRS_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
+	if (msg->payloadId != NMEA_MSG_GRS) return 0;
+
+	//$GNGRS,104148.00,1,2.6,2.2,-1.6,-1.1,-1.7,-1.5,5.8,1.7,,,,,1,1*52
+
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_GRS_TIME, 0, NMEA_Field_Time, &frame->time);
+	NMEA_DECODE_IF(NMEA_GRS_MODE, 1, NMEA_Field_Byte, &frame->mode);
+	if (mask & NMEA_GRS_RESIDUAL) {
+		frame->residual_n = 0;
+		for (uint8_t i = 0; i < NMEA_GRS_RESIDUALS; i++) {
+			NMEA_DECODE(2 + i, NMEA_Field_Float, &frame->residual[i]);
+			if (2 + i < fields.count && NMEA_FIELD_LEN(fields, 2 + i)) frame->residual_n = i + 1;
+		}
+	}
+	NMEA_DECODE_IF(NMEA_GRS_SYSTEM, 14, NMEA_Field_Byte, &frame->systemId);
+	NMEA_DECODE_IF(NMEA_GRS_SYSTEM, 15, NMEA_Field_Byte, &frame->signalId);
+	return 1;
+}
+
+uint8_t NMEA_GRS_Parse(NMEA_Payload_GRS_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_GRS_ParseMask(frame, msg, NMEA_GRS_ALL);
 }
 
 /* GSA  GNSS DOP and active satellites.
 */
-uint8_t NMEA_GSA_Parse(NMEA_Payload_GSA_t* frame, const NMEA_Message_t* msg) {
+uint8_t NMEA_GSA_ParseMask(NMEA_Payload_GSA_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
 	if (msg->payloadId != NMEA_MSG_GSA) return 0;
 
 	//$GPGSA,A,3,23,29,07,08,09,18,26,28,,,,,1.94,1.18,1.54,1*0D
 
-	return NMEA_Scan(msg, "ciiiiiiiiiiiiifffi",
-		&frame->opMode,
-		&frame->navMode,
-		&frame->sats[0],
-		&frame->sats[1],
-		&frame->sats[2],
-		&frame->sats[3],
-		&frame->sats[4],
-		&frame->sats[5],
-		&frame->sats[6],
-		&frame->sats[7],
-		&frame->sats[8],
-		&frame->sats[9],
-		&frame->sats[10],
-		&frame->sats[11],
-		&frame->pdop,
-		&frame->hdop,
-		&frame->vdop,
-		&frame->fix_type
-	);
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_GSA_OPMODE, 0, NMEA_Field_Char, &frame->opMode);
+	NMEA_DECODE_IF(NMEA_GSA_NAVMODE, 1, NMEA_Field_Byte, &frame->navMode);
+	for (uint8_t i = 0; i < 12; i++) {
+		NMEA_DECODE_IF(NMEA_GSA_SATS, 2 + i, NMEA_Field_Byte, &frame->sats[i]);
+	}
+	NMEA_DECODE_IF(NMEA_GSA_PDOP, 14, NMEA_Field_Float, &frame->pdop);
+	NMEA_DECODE_IF(NMEA_GSA_HDOP, 15, NMEA_Field_Float, &frame->hdop);
+	NMEA_DECODE_IF(NMEA_GSA_VDOP, 16, NMEA_Field_Float, &frame->vdop);
+	NMEA_DECODE_IF(NMEA_GSA_FIXTYPE, 17, NMEA_Field_Byte, &frame->fix_type);
+	return 1;
+}
+
+uint8_t NMEA_GSA_Parse(NMEA_Payload_GSA_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_GSA_ParseMask(frame, msg, NMEA_GSA_ALL);
 }
 
 /* GST  GNSS pseudorange error statistics.
 */
-uint8_t NMEA_GST_Parse(NMEA_Payload_GST_t* frame, const NMEA_Message_t* msg) {
+uint8_t NMEA_GST_ParseMask(NMEA_Payload_GST_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
 	if (msg->payloadId != NMEA_MSG_GST) return 0;
 
 	//$GPGST,082356.00,1.8,,,,1.7,1.3,2.2*7E
 
-	return (uint8_t)NMEA_Scan(msg, "Tfffffff",
-		&frame->time,
-		&frame->rangeRms,
-		&frame->stdMajor,
-		&frame->stdMinor,
-		&frame->orient,
-		&frame->stdLat,
-		&frame->stdLon,
-		&frame->stdAlt
-	);
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_GST_TIME, 0, NMEA_Field_Time, &frame->time);
+	NMEA_DECODE_IF(NMEA_GST_RANGERMS, 1, NMEA_Field_Float, &frame->rangeRms);
+	NMEA_DECODE_IF(NMEA_GST_STDMAJOR, 2, NMEA_Field_Float, &frame->stdMajor);
+	NMEA_DECODE_IF(NMEA_GST_STDMINOR, 3, NMEA_Field_Float, &frame->stdMinor);
+	NMEA_DECODE_IF(NMEA_GST_ORIENT, 4, NMEA_Field_Float, &frame->orient);
+	NMEA_DECODE_IF(NMEA_GST_STDLAT, 5, NMEA_Field_Float, &frame->stdLat);
+	NMEA_DECODE_IF(NMEA_GST_STDLON, 6, NMEA_Field_Float, &frame->stdLon);
+	NMEA_DECODE_IF(NMEA_GST_STDALT, 7, NMEA_Field_Float, &frame->stdAlt);
+	return 1;
+}
+
+uint8_t NMEA_GST_Parse(NMEA_Payload_GST_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_GST_ParseMask(frame, msg, NMEA_GST_ALL);
 }
 
 /* GSV  GNSS satellites in view.
 */
-uint8_t NMEA_GSV_Parse(NMEA_Payload_GSV_t* frame, const NMEA_Message_t* msg) {
+uint8_t NMEA_GSV_ParseMask(NMEA_Payload_GSV_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
 	if (msg->payloadId != NMEA_MSG_GSV) return 0;
 
 	//$GPGSV,1,1,03,12,,,42,24,,,47,32,,,37,5*66
 
-	return (uint8_t)NMEA_Scan(msg, "iiddddddddddddddddd",
-		&frame->msgNum,
-		&frame->numMsg,
-		&frame->numSV,
-		&frame->sats[0].nr,
-		&frame->sats[0].elevation,
-		&frame->sats[0].azimuth,
-		&frame->sats[0].snr,
-		&frame->sats[1].nr,
-		&frame->sats[1].elevation,
-		&frame->sats[1].azimuth,
-		&frame->sats[1].snr,
-		&frame->sats[2].nr,
-		&frame->sats[2].elevation,
-		&frame->sats[2].azimuth,
-		&frame->sats[2].snr,
-		&frame->sats[3].nr,
-		&frame->sats[3].elevation,
-		&frame->sats[3].azimuth,
-		&frame->sats[3].snr
-	);
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_GSV_MSG, 0, NMEA_Field_Byte, &frame->numMsg);
+	NMEA_DECODE_IF(NMEA_GSV_MSG, 1, NMEA_Field_Byte, &frame->msgNum);
+	NMEA_DECODE_IF(NMEA_GSV_NUMSV, 2, NMEA_Field_Int, &frame->numSV);
+
+	/* Whole 4 field blocks only, an odd trailing field is the signal ID. */
+	uint8_t blocks = (fields.count > 3) ? (uint8_t)((fields.count - 3) / 4) : 0;
+	if (blocks > 4) blocks = 4;
+
+	if (mask & NMEA_GSV_SIGNAL) frame->signalId = 0;
+	if (fields.count > 3 && (fields.count - 3) % 4 == 1) {
+		NMEA_DECODE_IF(NMEA_GSV_SIGNAL, 3 + blocks * 4, NMEA_Field_Byte, &frame->signalId);
+	}
+
+	for (uint8_t i = 0; i < blocks; i++) {
+		NMEA_DECODE_IF(NMEA_GSV_SATS, 3 + i * 4, NMEA_Field_Int, &frame->sats[i].nr);
+		NMEA_DECODE_IF(NMEA_GSV_SATS, 4 + i * 4, NMEA_Field_Int, &frame->sats[i].elevation);
+		NMEA_DECODE_IF(NMEA_GSV_SATS, 5 + i * 4, NMEA_Field_Int, &frame->sats[i].azimuth);
+		NMEA_DECODE_IF(NMEA_GSV_SATS, 6 + i * 4, NMEA_Field_Int, &frame->sats[i].snr);
+	}
+	return 1;
+}
+
+uint8_t NMEA_GSV_Parse(NMEA_Payload_GSV_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_GSV_ParseMask(frame, msg, NMEA_GSV_ALL);
 }
 
 /* RMC Recommended minimum data. (I don't recommend)
 */
-uint8_t NMEA_RMC_Parse(NMEA_Payload_RMC_t* frame, const NMEA_Message_t* msg) {
+uint8_t NMEA_RMC_ParseMask(NMEA_Payload_RMC_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
 	if (msg->payloadId != NMEA_MSG_RMC) return 0;
 
 	//$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*57
 
-	return (uint8_t)NMEA_Scan(msg, "TcLqLqffDf_c",
-		&frame->time,
-		&frame->status,
-		&frame->location.latitude,
-		&frame->location.ns_d,
-		&frame->location.longitude,
-		&frame->location.ew_d,
-		&frame->speed,
-		&frame->course,
-		&frame->date,
-		&frame->variation,
-		&frame->posMode
-	);
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_RMC_TIME, 0, NMEA_Field_Time, &frame->time);
+	NMEA_DECODE_IF(NMEA_RMC_STATUS, 1, NMEA_Field_Char, &frame->status);
+	NMEA_DECODE_IF(NMEA_RMC_LOCATION, 2, NMEA_Field_Location, &frame->location.latitude);
+	NMEA_DECODE_IF(NMEA_RMC_LOCATION, 3, NMEA_Field_Direction, &frame->location.ns_d);
+	NMEA_DECODE_IF(NMEA_RMC_LOCATION, 4, NMEA_Field_Location, &frame->location.longitude);
+	NMEA_DECODE_IF(NMEA_RMC_LOCATION, 5, NMEA_Field_Direction, &frame->location.ew_d);
+	NMEA_DECODE_IF(NMEA_RMC_SPEED, 6, NMEA_Field_Float, &frame->speed);
+	NMEA_DECODE_IF(NMEA_RMC_COURSE, 7, NMEA_Field_Float, &frame->course);
+	NMEA_DECODE_IF(NMEA_RMC_DATE, 8, NMEA_Field_Date, &frame->date);
+	NMEA_DECODE_IF(NMEA_RMC_VARIATION, 9, NMEA_Field_Float, &frame->variation);
+	NMEA_DECODE_IF(NMEA_RMC_POSMODE, 11, NMEA_Field_Char, &frame->posMode);
+	NMEA_DECODE_IF(NMEA_RMC_NAVSTATUS, 12, NMEA_Field_Char, &frame->navStatus);
+	return 1;
+}
+
+uint8_t NMEA_RMC_Parse(NMEA_Payload_RMC_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_RMC_ParseMask(frame, msg, NMEA_RMC_ALL);
 }
 
 
+/* TXT Text transmission. The text runs up to the checksum, commas included.
+*/
+uint8_t NMEA_TXT_ParseMask(NMEA_Payload_TXT_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
+	if (msg->payloadId != NMEA_MSG_TXT) return 0;
+
+	//$GPTXT,01,01,02,u-blox ag - www.u-blox.com*50
+
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_TXT_MSG, 0, NMEA_Field_Byte, &frame->numMsg);
+	NMEA_DECODE_IF(NMEA_TXT_MSG, 1, NMEA_Field_Byte, &frame->msgNum);
+	NMEA_DECODE_IF(NMEA_TXT_MSG, 2, NMEA_Field_Byte, &frame->msgType);
+	if ((mask & NMEA_TXT_TEXT) && 3 < fields.count) {
+		NMEA_Field_Text((const char*)&msg->payload[fields.offset[3]],
+			(uint8_t)(fields.offset[fields.count] - fields.offset[3] - 1), frame->text, sizeof(frame->text));
+	}
+	return 1;
+}
+
+uint8_t NMEA_TXT_Parse(NMEA_Payload_TXT_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_TXT_ParseMask(frame, msg, NMEA_TXT_ALL);
+}
+
+/* VLW Dual ground/water distance.
+*/
+uint8_t NMEA_VLW_ParseMask(NMEA_Payload_VLW_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
+	if (msg->payloadId != NMEA_MSG_VLW) return 0;
+
+	//$GPVLW,,N,,N,15.8,N,1.2,N*65
+
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_VLW_WATER, 0, NMEA_Field_Float, &frame->twd);
+	NMEA_DECODE_IF(NMEA_VLW_WATER, 2, NMEA_Field_Float, &frame->wd);
+	NMEA_DECODE_IF(NMEA_VLW_GROUND, 4, NMEA_Field_Float, &frame->tgd);
+	NMEA_DECODE_IF(NMEA_VLW_GROUND, 6, NMEA_Field_Float, &frame->gd);
+	return 1;
+}
+
+uint8_t NMEA_VLW_Parse(NMEA_Payload_VLW_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_VLW_ParseMask(frame, msg, NMEA_VLW_ALL);
+}
+
 /* VTG  Course over ground and ground speed.
 */
-uint8_t NMEA_VTG_Parse(NMEA_Payload_VTG_t* frame, const NMEA_Message_t* msg) {
+uint8_t NMEA_VTG_ParseMask(NMEA_Payload_VTG_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
 	if (msg->payloadId != NMEA_MSG_VTG) return 0;
 
 	//$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06
 
-	return (uint8_t)NMEA_Scan(msg, "f_f_f_f_c",
-		&frame->cogt,
-		&frame->cogm,
-		&frame->sogn,
-		&frame->sogk,
-		&frame->posMode
-	);
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_VTG_COGT, 0, NMEA_Field_Float, &frame->cogt);
+	NMEA_DECODE_IF(NMEA_VTG_COGM, 2, NMEA_Field_Float, &frame->cogm);
+	NMEA_DECODE_IF(NMEA_VTG_SOGN, 4, NMEA_Field_Float, &frame->sogn);
+	NMEA_DECODE_IF(NMEA_VTG_SOGK, 6, NMEA_Field_Float, &frame->sogk);
+	NMEA_DECODE_IF(NMEA_VTG_POSMODE, 8, NMEA_Field_Char, &frame->posMode);
+	return 1;
+}
+
+uint8_t NMEA_VTG_Parse(NMEA_Payload_VTG_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_VTG_ParseMask(frame, msg, NMEA_VTG_ALL);
 }
 
 /* ZDA Time and Date.
 */
-uint8_t NMEA_ZDA_Parse(NMEA_Payload_ZDA_t* frame, const NMEA_Message_t* msg) {
+uint8_t NMEA_ZDA_ParseMask(NMEA_Payload_ZDA_t* frame, const NMEA_Message_t* msg, uint32_t mask) {
 	if (msg->payloadId != NMEA_MSG_ZDA) return 0;
 
 	//$GPZDA,082710.00,16,09,2002,00,00*64
 
-	return (uint8_t)NMEA_Scan(msg, "Tddddd",
-		&frame->time,
-		&frame->date.day,
-		&frame->date.month,
-		&frame->date.year,
-		&frame->hour_offset,
-		&frame->minute_offset
-	);
+	NMEA_Fields_t fields;
+	NMEA_Index(&fields, msg);
+
+	NMEA_DECODE_IF(NMEA_ZDA_TIME, 0, NMEA_Field_Time, &frame->time);
+	NMEA_DECODE_IF(NMEA_ZDA_DATE, 1, NMEA_Field_Int, &frame->date.day);
+	NMEA_DECODE_IF(NMEA_ZDA_DATE, 2, NMEA_Field_Int, &frame->date.month);
+	NMEA_DECODE_IF(NMEA_ZDA_DATE, 3, NMEA_Field_Int, &frame->date.year);
+	NMEA_DECODE_IF(NMEA_ZDA_OFFSET, 4, NMEA_Field_Int, &frame->hour_offset);
+	NMEA_DECODE_IF(NMEA_ZDA_OFFSET, 5, NMEA_Field_Int, &frame->minute_offset);
+	return 1;
+}
+
+uint8_t NMEA_ZDA_Parse(NMEA_Payload_ZDA_t* frame, const NMEA_Message_t* msg) {
+	return NMEA_ZDA_ParseMask(frame, msg, NMEA_ZDA_ALL);
 }
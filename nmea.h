@@ -21,6 +21,39 @@
  *  
  *  18.01.2024 : ID search optimization.
  *
+ *  16.10.2026 : NMEA_Parser_t context. Removed file-static cursor & ID buffers,
+ *  all Pack/Scan/Parse calls are reentrant.
+ *
+ *  16.10.2026 : NMEA_Feed, streaming byte-level framer.
+ *
+ *  16.10.2026 : Checksum validation fused into framing & packing.
+ *
+ *  16.10.2026 : Perfect hash talker & payload ID lookup, GQ/BD/GI/$P talkers.
+ *
+ *  16.10.2026 : Dedicated integer / decimal scanners, no strtol & strtod.
+ *
+ *  16.10.2026 : NMEA_Index, vectorized field separator index (SSE2/AVX2/NEON).
+ *
+ *  16.10.2026 : Specialized straight-line per-type parsers, NMEA_Scan kept
+ *  for ad-hoc formats.
+ *
+ *  16.10.2026 : GSV numMsg / msgNum field order fixed, the message count comes first.
+ *
+ *  16.10.2026 : NMEA_Dispatch, typed handlers by payload ID jump table.
+ *
+ *  16.10.2026 : NMEA_View_t, lazy field access with cached typed accessors.
+ *
+ *  16.10.2026 : NMEA_*_ParseMask, member projection for the per-type parsers.
+ *
+ *  16.10.2026 : GGA HDOP, altitude, geoid separation & differential fields.
+ *
+ *  16.10.2026 : Added DTM, GNS, GRS, TXT, VLW parsers.
+ *
+ *  16.10.2026 : Millisecond time of day, exact 1e-7 degree locations.
+ *
+ *  16.10.2026 : RMC navStatus decoded. GSV reads whole satellite blocks only, the
+ *               trailing signal ID is no longer taken for a satellite.
+ *
  *	References:
  *  [0] The National Marine Electronics Association (NMEA) 0183. Manual Klaus Betke, May 2000. Revised August 2001.
  *	[1] u-blox8-M8_ReceiverDescrProtSpec_(UBX-13003221)
@@ -34,6 +67,26 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+#ifndef NMEA_MAX_MESSAGE_LEN
+#define NMEA_MAX_MESSAGE_LEN  	80		// Longest framed sentence, '$' to checksum.
+#endif
+
+/* NMEA_Parser_t.length and NMEA_Message_t.length are 8 bit. */
+#if NMEA_MAX_MESSAGE_LEN > 255 || NMEA_MAX_MESSAGE_LEN < 20
+#error "NMEA_MAX_MESSAGE_LEN must be within 20..255"
+#endif
+
+#ifndef NMEA_MAX_FIELDS
+#define NMEA_MAX_FIELDS			40		// Indexed payload fields per sentence.
+#endif
+
+#define NMEA_DATUM_LEN			5		// Datum code, "W84" / "999" / sub-datum
+#define NMEA_GNS_MODES			6		// GNS posMode chars: GPS, GLONASS, Galileo, BeiDou, QZSS, NavIC
+#define NMEA_GRS_RESIDUALS		12
+#define NMEA_TXT_LEN			(NMEA_MAX_MESSAGE_LEN - 19)	// "$xxTXT,nn,nn,nn," & "*hh" excluded
 
 typedef enum {
 	NMEA_TALKER_GP = 1,		//GPS, SBAS, QZSS
@@ -41,6 +94,10 @@ typedef enum {
 	NMEA_TALKER_GA,			//Galileo
 	NMEA_TALKER_GB,			//BeiDou
 	NMEA_TALKER_GN,			//GNSS Combination
+	NMEA_TALKER_GQ,			//QZSS
+	NMEA_TALKER_BD,			//BeiDou (NMEA 4.0 and older)
+	NMEA_TALKER_GI,			//NavIC
+	NMEA_TALKER_P,			//Proprietary '$P' sentence, payloadId is 0
 }NMEA_talkerId_e;
 
 typedef enum {
@@ -70,7 +127,7 @@ typedef struct NMEA_Message_s {
 	uint8_t payloadId;
 	uint8_t* rawdata;
 	uint8_t* payload;
-	uint8_t length;
+	uint8_t length;		// Sentence length, '$' to the end of checksum trailer
 }NMEA_Message_t;
 
 typedef struct NMEA_Date_s {
@@ -83,6 +140,7 @@ typedef struct NMEA_Time_s {
 	int8_t hour;
 	int8_t min;
 	int8_t sec;
+	int32_t ms;			// Milliseconds since midnight, fraction included. -1 if empty
 }NMEA_Time_t;
 
 typedef struct NMEA_SatInfo_s {
@@ -93,8 +151,8 @@ typedef struct NMEA_SatInfo_s {
 }NMEA_SatInfo_t;
 
 typedef struct NMEA_Location_s {
-	int32_t latitude;	// Degrees as integer
-	int32_t longitude;	// Degrees as integer
+	int32_t latitude;	// Degrees, 1e-7 fixed point
+	int32_t longitude;	// Degrees, 1e-7 fixed point
 	int8_t ns_d;		// North South Direction
 	int8_t ew_d;		// East West Direction
 }NMEA_Location_t;
@@ -102,6 +160,25 @@ typedef struct NMEA_Location_s {
 /*
 *  Payload Structs
 */
+typedef struct NMEA_Payload_DTM_s {
+	char datum[NMEA_DATUM_LEN + 1];
+	char subDatum[NMEA_DATUM_LEN + 1];
+	float latOffset;		// Minutes
+	int8_t ns_d;
+	float lonOffset;		// Minutes
+	int8_t ew_d;
+	float altOffset;		// Meters
+	char refDatum[NMEA_DATUM_LEN + 1];
+}NMEA_Payload_DTM_t;
+
+/* NMEA_DTM_ParseMask members. */
+typedef enum {
+	NMEA_DTM_DATUM = 0x01,		// datum, subDatum
+	NMEA_DTM_OFFSET = 0x02,		// latOffset, ns_d, lonOffset, ew_d, altOffset
+	NMEA_DTM_REFDATUM = 0x04,
+	NMEA_DTM_ALL = 0x07,
+}NMEA_dtmMember_e;
+
 typedef struct NMEA_Payload_GBS_s {
 	NMEA_Time_t time;
 	float errLat;
@@ -113,13 +190,44 @@ typedef struct NMEA_Payload_GBS_s {
 	float stddev;
 }NMEA_Payload_GBS_t;
 
+/* NMEA_GBS_ParseMask members. */
+typedef enum {
+	NMEA_GBS_TIME = 0x01,
+	NMEA_GBS_ERRLAT = 0x02,
+	NMEA_GBS_ERRLON = 0x04,
+	NMEA_GBS_ERRALT = 0x08,
+	NMEA_GBS_SVID = 0x10,
+	NMEA_GBS_PROB = 0x20,
+	NMEA_GBS_BIAS = 0x40,
+	NMEA_GBS_STDDEV = 0x80,
+	NMEA_GBS_ALL = 0xFF,
+}NMEA_gbsMember_e;
+
 typedef struct NMEA_Payload_GGA_s {
 	NMEA_Time_t time;
 	NMEA_Location_t location;
 	uint8_t quality;
 	uint8_t satellite_n;
+	float hdop;
+	float altitude;			// Above mean sea level, meters
+	float separation;		// Geoid separation, meters
+	float diffAge;			// Age of differential corrections, seconds, 0 if none
+	int32_t diffStation;	// Differential station ID, 0 if none
 }NMEA_Payload_GGA_t;
 
+/* NMEA_GGA_ParseMask members. */
+typedef enum {
+	NMEA_GGA_TIME = 0x01,
+	NMEA_GGA_LOCATION = 0x02,	// latitude, ns_d, longitude, ew_d
+	NMEA_GGA_QUALITY = 0x04,
+	NMEA_GGA_SATELLITES = 0x08,
+	NMEA_GGA_HDOP = 0x10,
+	NMEA_GGA_ALTITUDE = 0x20,
+	NMEA_GGA_SEPARATION = 0x40,
+	NMEA_GGA_DIFF = 0x80,		// diffAge, diffStation
+	NMEA_GGA_ALL = 0xFF,
+}NMEA_ggaMember_e;
+
 typedef struct NMEA_Payload_GLL_s {
 	NMEA_Location_t location;
 	NMEA_Time_t time;
@@ -128,6 +236,60 @@ typedef struct NMEA_Payload_GLL_s {
 	char posMode;
 }NMEA_Payload_GLL_t;
 
+/* NMEA_GLL_ParseMask members. */
+typedef enum {
+	NMEA_GLL_LOCATION = 0x01,	// latitude, ns_d, longitude, ew_d
+	NMEA_GLL_TIME = 0x02,
+	NMEA_GLL_STATUS = 0x04,
+	NMEA_GLL_POSMODE = 0x08,
+	NMEA_GLL_ALL = 0x0F,
+}NMEA_gllMember_e;
+
+typedef struct NMEA_Payload_GNS_s {
+	NMEA_Time_t time;
+	NMEA_Location_t location;
+	char posMode[NMEA_GNS_MODES + 1];	// One mode char per constellation, NUL terminated
+	uint8_t numSV;
+	float hdop;
+	float altitude;			// Above mean sea level, meters
+	float separation;		// Geoid separation, meters
+	float diffAge;
+	int32_t diffStation;
+	char navStatus;
+}NMEA_Payload_GNS_t;
+
+/* NMEA_GNS_ParseMask members. */
+typedef enum {
+	NMEA_GNS_TIME = 0x01,
+	NMEA_GNS_LOCATION = 0x02,	// latitude, ns_d, longitude, ew_d
+	NMEA_GNS_POSMODE = 0x04,
+	NMEA_GNS_NUMSV = 0x08,
+	NMEA_GNS_HDOP = 0x10,
+	NMEA_GNS_ALTITUDE = 0x20,
+	NMEA_GNS_SEPARATION = 0x40,
+	NMEA_GNS_DIFF = 0x80,		// diffAge, diffStation
+	NMEA_GNS_NAVSTATUS = 0x100,
+	NMEA_GNS_ALL = 0x1FF,
+}NMEA_gnsMember_e;
+
+typedef struct NMEA_Payload_GRS_s {
+	NMEA_Time_t time;
+	uint8_t mode;			// 0 : residuals used in the solution, 1 : recomputed after it
+	uint8_t residual_n;		// Residual slots up to the last non-empty one
+	float residual[NMEA_GRS_RESIDUALS];		// Meters, GSA satellite order, 0 if empty
+	uint8_t systemId;
+	uint8_t signalId;
+}NMEA_Payload_GRS_t;
+
+/* NMEA_GRS_ParseMask members. */
+typedef enum {
+	NMEA_GRS_TIME = 0x01,
+	NMEA_GRS_MODE = 0x02,
+	NMEA_GRS_RESIDUAL = 0x04,	// residual_n, residual[12]
+	NMEA_GRS_SYSTEM = 0x08,		// systemId, signalId
+	NMEA_GRS_ALL = 0x0F,
+}NMEA_grsMember_e;
+
 typedef struct NMEA_Payload_GST_s {
 	NMEA_Time_t time;
 	float rangeRms;
@@ -139,6 +301,19 @@ typedef struct NMEA_Payload_GST_s {
 	float stdAlt;
 }NMEA_Payload_GST_t;
 
+/* NMEA_GST_ParseMask members. */
+typedef enum {
+	NMEA_GST_TIME = 0x01,
+	NMEA_GST_RANGERMS = 0x02,
+	NMEA_GST_STDMAJOR = 0x04,
+	NMEA_GST_STDMINOR = 0x08,
+	NMEA_GST_ORIENT = 0x10,
+	NMEA_GST_STDLAT = 0x20,
+	NMEA_GST_STDLON = 0x40,
+	NMEA_GST_STDALT = 0x80,
+	NMEA_GST_ALL = 0xFF,
+}NMEA_gstMember_e;
+
 typedef struct NMEA_Payload_GSA_s {
 	char opMode;
 	uint8_t navMode;
@@ -149,13 +324,36 @@ typedef struct NMEA_Payload_GSA_s {
 	float vdop;
 }NMEA_Payload_GSA_t;
 
+/* NMEA_GSA_ParseMask members. */
+typedef enum {
+	NMEA_GSA_OPMODE = 0x01,
+	NMEA_GSA_NAVMODE = 0x02,
+	NMEA_GSA_SATS = 0x04,	// sats[12]
+	NMEA_GSA_PDOP = 0x08,
+	NMEA_GSA_HDOP = 0x10,
+	NMEA_GSA_VDOP = 0x20,
+	NMEA_GSA_FIXTYPE = 0x40,
+	NMEA_GSA_DOP = 0x38,	// pdop, hdop, vdop
+	NMEA_GSA_ALL = 0x7F,
+}NMEA_gsaMember_e;
+
 typedef struct NMEA_Payload_GSV_s {
 	uint8_t numMsg;
 	uint8_t msgNum;
 	int32_t numSV;
 	NMEA_SatInfo_t sats[4];
+	uint8_t signalId;		// NMEA 4.10 trailing field, 0 if absent
 }NMEA_Payload_GSV_t;
 
+/* NMEA_GSV_ParseMask members. */
+typedef enum {
+	NMEA_GSV_MSG = 0x01,	// numMsg, msgNum
+	NMEA_GSV_NUMSV = 0x02,
+	NMEA_GSV_SATS = 0x04,	// sats[4]
+	NMEA_GSV_SIGNAL = 0x08,
+	NMEA_GSV_ALL = 0x0F,
+}NMEA_gsvMember_e;
+
 typedef struct NMEA_Payload_RMC_s {
 	NMEA_Time_t time;
 	char status;
@@ -168,6 +366,48 @@ typedef struct NMEA_Payload_RMC_s {
 	char navStatus;
 }NMEA_Payload_RMC_t;
 
+/* NMEA_RMC_ParseMask members. */
+typedef enum {
+	NMEA_RMC_TIME = 0x01,
+	NMEA_RMC_STATUS = 0x02,
+	NMEA_RMC_LOCATION = 0x04,	// latitude, ns_d, longitude, ew_d
+	NMEA_RMC_SPEED = 0x08,
+	NMEA_RMC_COURSE = 0x10,
+	NMEA_RMC_DATE = 0x20,
+	NMEA_RMC_VARIATION = 0x40,
+	NMEA_RMC_POSMODE = 0x80,
+	NMEA_RMC_NAVSTATUS = 0x100,
+	NMEA_RMC_ALL = 0x1FF,
+}NMEA_rmcMember_e;
+
+typedef struct NMEA_Payload_TXT_s {
+	uint8_t numMsg;
+	uint8_t msgNum;
+	uint8_t msgType;		// 0 error, 1 warning, 2 notice, 7 user
+	char text[NMEA_TXT_LEN + 1];
+}NMEA_Payload_TXT_t;
+
+/* NMEA_TXT_ParseMask members. */
+typedef enum {
+	NMEA_TXT_MSG = 0x01,		// numMsg, msgNum, msgType
+	NMEA_TXT_TEXT = 0x02,
+	NMEA_TXT_ALL = 0x03,
+}NMEA_txtMember_e;
+
+typedef struct NMEA_Payload_VLW_s {
+	float twd;				// Total cumulative water distance, nautical miles
+	float wd;				// Water distance since reset
+	float tgd;				// Total cumulative ground distance
+	float gd;				// Ground distance since reset
+}NMEA_Payload_VLW_t;
+
+/* NMEA_VLW_ParseMask members. */
+typedef enum {
+	NMEA_VLW_WATER = 0x01,		// twd, wd
+	NMEA_VLW_GROUND = 0x02,		// tgd, gd
+	NMEA_VLW_ALL = 0x03,
+}NMEA_vlwMember_e;
+
 typedef struct NMEA_Payload_VTG_s {
 	float cogt;
 	float cogm;
@@ -176,6 +416,16 @@ typedef struct NMEA_Payload_VTG_s {
 	char posMode;
 }NMEA_Payload_VTG_t;
 
+/* NMEA_VTG_ParseMask members. */
+typedef enum {
+	NMEA_VTG_COGT = 0x01,
+	NMEA_VTG_COGM = 0x02,
+	NMEA_VTG_SOGN = 0x04,
+	NMEA_VTG_SOGK = 0x08,
+	NMEA_VTG_POSMODE = 0x10,
+	NMEA_VTG_ALL = 0x1F,
+}NMEA_vtgMember_e;
+
 typedef struct NMEA_Payload_ZDA_s {
 	NMEA_Time_t time;
 	NMEA_Date_t date;
@@ -183,13 +433,127 @@ typedef struct NMEA_Payload_ZDA_s {
 	int32_t minute_offset;
 }NMEA_Payload_ZDA_t;
 
+/* NMEA_ZDA_ParseMask members. */
+typedef enum {
+	NMEA_ZDA_TIME = 0x01,
+	NMEA_ZDA_DATE = 0x02,
+	NMEA_ZDA_OFFSET = 0x04,	// hour_offset, minute_offset
+	NMEA_ZDA_ALL = 0x07,
+}NMEA_zdaMember_e;
+
+/*
+*  Payload field index. Field n spans payload[offset[n] + 1] up to the
+*  separator at payload[offset[n + 1]], offset[count] is the closing '*'.
+*/
+typedef struct NMEA_Fields_s {
+	uint8_t count;
+	uint8_t offset[NMEA_MAX_FIELDS + 1];
+}NMEA_Fields_t;
+
+#if NMEA_MAX_FIELDS > 64
+#error "NMEA_View_t caches at most 64 fields"
+#endif
+
+/*
+*  Lazy message view. The payload is indexed once at NMEA_View_Init, typed
+*  accessors decode a field on the first read and cache the value; fields
+*  that are never read are never converted.
+*/
+typedef struct NMEA_View_s {
+	const NMEA_Message_t* msg;
+	NMEA_Fields_t fields;
+	uint64_t cached;					// Bit n: value[n] holds field n as kind[n]
+	uint8_t kind[NMEA_MAX_FIELDS];
+	union {
+		double f;
+		int32_t i;
+		char c;
+		NMEA_Time_t t;
+	} value[NMEA_MAX_FIELDS];
+}NMEA_View_t;
+
+/*
+*  Framed sentence callback. msg->rawdata points the parser line buffer, it is
+*  valid until the callback returns.
+*/
+typedef void (*NMEA_Callback_t)(const NMEA_Message_t* msg, void* user);
+
+typedef enum {
+	NMEA_FRAME_IDLE = 0,	// Hunting '$'
+	NMEA_FRAME_BODY,		// Collecting sentence bytes
+	NMEA_FRAME_CHECKSUM,	// Collecting '*hh' trailer
+}NMEA_frameState_e;
+
+typedef enum {
+	NMEA_PARSER_CHECKSUM = 0x01,	// Reject sentences without a matching '*hh' trailer
+}NMEA_parserFlag_e;
+
+/*
+*  Parser Context
+*  Holds every state of a parsing stream. There is no file-static state in the
+*  library, one context per thread / per receiver feed needs no locking.
+*/
+typedef struct NMEA_Parser_s {
+	uint32_t packed;	// Sentences accepted by NMEA_Parser_Pack
+	uint32_t rejected;	// Sentences rejected by NMEA_Parser_Pack
+	uint32_t overflows;	// Framed lines dropped, longer than NMEA_MAX_MESSAGE_LEN
+	uint32_t checksumErrors;	// Sentences dropped by NMEA_PARSER_CHECKSUM validation
+
+	NMEA_Callback_t callback;
+	void* user;
+	uint8_t flags;		// NMEA_parserFlag_e
+
+	uint8_t state;		// NMEA_frameState_e
+	uint8_t checksum;	// Running XOR of the collected payload
+	uint8_t trailer;	// Received '*hh' value
+	uint8_t digits;		// Received trailer digits
+	uint8_t length;
+	uint8_t line[NMEA_MAX_MESSAGE_LEN + 1];
+}NMEA_Parser_t;
+
 ////////////////////////////////////////////////////////////////////////////////////////
 
+void NMEA_Parser_Init(NMEA_Parser_t* ctx);
+
+/**
+ * Packs a '$' started sentence, terminated by NUL, CR or LF. The sentence is
+ * walked once: the end is found and the XOR checksum computed together. With
+ * NMEA_PARSER_CHECKSUM set on ctx->flags, sentences with a missing or wrong
+ * trailer are rejected before any field is converted.
+ */
+bool NMEA_Parser_Pack(NMEA_Parser_t* ctx, NMEA_Message_t* ref, const uint8_t* raw_sentence);
+
+void NMEA_Parser_SetCallback(NMEA_Parser_t* ctx, NMEA_Callback_t callback, void* user);
+
+/**
+ * Incremental framer. Feed any chunk of a serial / socket stream, sentences
+ * split between chunks are joined. Every complete '$'...<CR|LF> line is packed
+ * and handed to the context callback. Garbage between sentences is skipped,
+ * a '$' inside a sentence restarts framing at that byte.
+ * Returns the count of sentences emitted from this chunk.
+ */
+uint32_t NMEA_Feed(NMEA_Parser_t* ctx, const uint8_t* buf, size_t len);
+
+/* Context free wrapper of NMEA_Parser_Pack. Reentrant. */
 bool NMEA_Pack(NMEA_Message_t* ref, const uint8_t* raw_sentence);
 
+/* XOR of all bytes between '$' and '*'. */
+uint8_t NMEA_Checksum(const char* msg);
+
+/* Reads exactly 2 / 3 ID bytes, no terminator needed. Returns 0 if unknown. */
 uint8_t NMEA_Find_TalkerID(const char* msg);
 uint8_t NMEA_Find_PayloadID(const char* msg);
 
+/**
+ * Indexes every field separator of the payload in one vectorized sweep.
+ * Uses msg->length as the bound, falls back to the sentence terminator if 0.
+ * Returns the field count.
+ */
+uint8_t NMEA_Index(NMEA_Fields_t* fields, const NMEA_Message_t* msg);
+
+/* Start of field n (0 based, after the address), NULL if there is no such field. */
+const char* NMEA_Field(const NMEA_Message_t* msg, const NMEA_Fields_t* fields, uint8_t n);
+
 /**
  * Scanf-like processor for NMEA sentences. Supports the following formats:
  * c - single character (char *)
@@ -206,26 +570,130 @@ uint8_t NMEA_Find_PayloadID(const char* msg);
  * Returns true on success. See library source code for details.
  */
 uint8_t NMEA_Scan(const NMEA_Message_t* msg, const char* format, ...);
+uint8_t NMEA_VScan(const NMEA_Message_t* msg, const char* format, va_list args);
+
+/* Indexes msg for lazy access. msg must stay valid while the view is used. */
+void NMEA_View_Init(NMEA_View_t* view, const NMEA_Message_t* msg);
+
+/**
+ * Typed accessors of field n (0 based, after the address). Empty fields give
+ * the NMEA_Scan defaults: 0, time / date -1, location -1.
+ * Return 0 if there is no field n or it doesn't hold the type.
+ */
+bool NMEA_View_Int(NMEA_View_t* view, uint8_t n, int32_t* out);
+bool NMEA_View_Double(NMEA_View_t* view, uint8_t n, double* out);
+bool NMEA_View_Char(NMEA_View_t* view, uint8_t n, char* out);
+bool NMEA_View_Time(NMEA_View_t* view, uint8_t n, NMEA_Time_t* out);
+bool NMEA_View_Date(NMEA_View_t* view, uint8_t n, NMEA_Date_t* out);
+
+/* Coordinate of field n with its N/S or E/W direction in field n + 1, NMEA_Location_t scale, signed. */
+bool NMEA_View_Location(NMEA_View_t* view, uint8_t n, int32_t* out);
+
+/*
+*  Any parsed payload, selected by NMEA_Message_t.payloadId.
+*/
+typedef union NMEA_Payload_u {
+	NMEA_Payload_DTM_t dtm;
+	NMEA_Payload_GBS_t gbs;
+	NMEA_Payload_GGA_t gga;
+	NMEA_Payload_GLL_t gll;
+	NMEA_Payload_GNS_t gns;
+	NMEA_Payload_GRS_t grs;
+	NMEA_Payload_GSA_t gsa;
+	NMEA_Payload_GST_t gst;
+	NMEA_Payload_GSV_t gsv;
+	NMEA_Payload_RMC_t rmc;
+	NMEA_Payload_TXT_t txt;
+	NMEA_Payload_VLW_t vlw;
+	NMEA_Payload_VTG_t vtg;
+	NMEA_Payload_ZDA_t zda;
+}NMEA_Payload_t;
+
+/**
+ * Typed payload handler. frame holds the member of msg->payloadId, NULL for
+ * payload types without a parser. Both are valid until the handler returns.
+ */
+typedef void (*NMEA_PayloadHandler_t)(const NMEA_Message_t* msg, const NMEA_Payload_t* frame, void* user);
+
+/*
+*  Handler jump table indexed by NMEA_payloadId_e, entry 0 takes proprietary
+*  and unknown sentences. Read only while dispatching, can be shared.
+*/
+typedef struct NMEA_Handlers_s {
+	NMEA_PayloadHandler_t handler[NMEA_MSG_ZDA + 1];
+	void* user[NMEA_MSG_ZDA + 1];
+}NMEA_Handlers_t;
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
+/* Parses msg with the parser of its payloadId. Returns 0 if unsupported or failed. */
+uint8_t NMEA_Parse(NMEA_Payload_t* frame, const NMEA_Message_t* msg);
+
+void NMEA_Handlers_Init(NMEA_Handlers_t* handlers);
+
+/* Registers the handler of one payloadId, NULL unregisters. */
+void NMEA_Handlers_Set(NMEA_Handlers_t* handlers, uint8_t payloadId, NMEA_PayloadHandler_t handler, void* user);
+
+/**
+ * Packs raw with ctx (NMEA_PARSER_CHECKSUM applies), parses it into a stack
+ * frame and calls the registered handler. Sentences without a handler are
+ * dropped before any field is converted.
+ * Returns 1 if the handler was called.
+ */
+uint8_t NMEA_Dispatch(NMEA_Parser_t* ctx, const NMEA_Handlers_t* handlers, const uint8_t* raw_sentence);
+
+/* NMEA_Dispatch of an already packed sentence. */
+uint8_t NMEA_Dispatch_Message(const NMEA_Handlers_t* handlers, const NMEA_Message_t* msg);
+
+/* NMEA_Callback_t adapter, NMEA_Parser_SetCallback(&parser, NMEA_Dispatch_Callback, &handlers). */
+void NMEA_Dispatch_Callback(const NMEA_Message_t* msg, void* handlers);
+
+/**
+ * Per-type parsers. The _ParseMask variants fill only the members of mask
+ * (NMEA_*Member_e bits), fields of the other members are not converted and
+ * their members are left untouched. _Parse is _ParseMask with NMEA_*_ALL.
+ */
+uint8_t NMEA_DTM_Parse(NMEA_Payload_DTM_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_DTM_ParseMask(NMEA_Payload_DTM_t* frame, const NMEA_Message_t* msg, uint32_t mask);
+
 uint8_t NMEA_GBS_Parse(NMEA_Payload_GBS_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_GBS_ParseMask(NMEA_Payload_GBS_t* frame, const NMEA_Message_t* msg, uint32_t mask);
 
 uint8_t NMEA_GGA_Parse(NMEA_Payload_GGA_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_GGA_ParseMask(NMEA_Payload_GGA_t* frame, const NMEA_Message_t* msg, uint32_t mask);
 
 uint8_t NMEA_GLL_Parse(NMEA_Payload_GLL_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_GLL_ParseMask(NMEA_Payload_GLL_t* frame, const NMEA_Message_t* msg, uint32_t mask);
+
+uint8_t NMEA_GNS_Parse(NMEA_Payload_GNS_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_GNS_ParseMask(NMEA_Payload_GNS_t* frame, const NMEA_Message_t* msg, uint32_t mask);
+
+uint8_t NMEA_GRS_Parse(NMEA_Payload_GRS_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_GRS_ParseMask(NMEA_Payload_GRS_t* frame, const NMEA_Message_t* msg, uint32_t mask);
 
 uint8_t NMEA_GSA_Parse(NMEA_Payload_GSA_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_GSA_ParseMask(NMEA_Payload_GSA_t* frame, const NMEA_Message_t* msg, uint32_t mask);
 
 uint8_t NMEA_GST_Parse(NMEA_Payload_GST_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_GST_ParseMask(NMEA_Payload_GST_t* frame, const NMEA_Message_t* msg, uint32_t mask);
 
 uint8_t NMEA_GSV_Parse(NMEA_Payload_GSV_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_GSV_ParseMask(NMEA_Payload_GSV_t* frame, const NMEA_Message_t* msg, uint32_t mask);
 
 uint8_t NMEA_RMC_Parse(NMEA_Payload_RMC_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_RMC_ParseMask(NMEA_Payload_RMC_t* frame, const NMEA_Message_t* msg, uint32_t mask);
+
+uint8_t NMEA_TXT_Parse(NMEA_Payload_TXT_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_TXT_ParseMask(NMEA_Payload_TXT_t* frame, const NMEA_Message_t* msg, uint32_t mask);
+
+uint8_t NMEA_VLW_Parse(NMEA_Payload_VLW_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_VLW_ParseMask(NMEA_Payload_VLW_t* frame, const NMEA_Message_t* msg, uint32_t mask);
 
 uint8_t NMEA_VTG_Parse(NMEA_Payload_VTG_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_VTG_ParseMask(NMEA_Payload_VTG_t* frame, const NMEA_Message_t* msg, uint32_t mask);
 
 uint8_t NMEA_ZDA_Parse(NMEA_Payload_ZDA_t* frame, const NMEA_Message_t* msg);
+uint8_t NMEA_ZDA_ParseMask(NMEA_Payload_ZDA_t* frame, const NMEA_Message_t* msg, uint32_t mask);
 
 
 #endif /* NMEA_H */
@@ -0,0 +1,667 @@
+/*
+ *	nmea_archive.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Binary columnar archive of parsed payload structs.
+ *
+ *  16.10.2026 : File is created.
+ *  16.10.2026 : Blocks of another column layout are skipped, text columns of another width are read.
+ *
+ */
+
+#define _DEFAULT_SOURCE		// madvise
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "nmea_archive.h"
+
+#define ARC_ALIGN(n)		(((n) + 7) & ~(size_t)7)
+#define ARC_VARINT_MAX		5
+#define ARC_FIXED_COLUMNS	2		// talkerId, sequence
+
+typedef enum {
+	ARC_FIELD_RAW = 0,		// Member bytes as is
+	ARC_FIELD_TEXT,			// char array, raw; its width follows the build limits
+	ARC_FIELD_INT,			// int32_t member, delta coded
+	ARC_FIELD_TIME,			// NMEA_Time_t, ms delta coded
+	ARC_FIELD_DATE,			// NMEA_Date_t, yyyymmdd delta coded
+}Arc_fieldType_e;
+
+typedef struct Arc_Field_s {
+	const char* name;
+	uint16_t offset;
+	uint16_t width;
+	uint8_t type;
+}Arc_Field_t;
+
+typedef struct Arc_Layout_s {
+	const Arc_Field_t* fields;
+	uint8_t count;
+}Arc_Layout_t;
+
+#define ARC_MEMBER_SIZE(type, member)	sizeof(((NMEA_Payload_##type##_t*)0)->member)
+
+#define ARC_RAW(type, member)	{ #member, offsetof(NMEA_Payload_##type##_t, member), ARC_MEMBER_SIZE(type, member), ARC_FIELD_RAW }
+#define ARC_TEXT(type, member)	{ #member, offsetof(NMEA_Payload_##type##_t, member), ARC_MEMBER_SIZE(type, member), ARC_FIELD_TEXT }
+#define ARC_INT(type, member)	{ #member, offsetof(NMEA_Payload_##type##_t, member), 4, ARC_FIELD_INT }
+#define ARC_TIME(type, member)	{ #member, offsetof(NMEA_Payload_##type##_t, member), 4, ARC_FIELD_TIME }
+#define ARC_DATE(type, member)	{ #member, offsetof(NMEA_Payload_##type##_t, member), 4, ARC_FIELD_DATE }
+
+#define ARC_LOCATION(type) \
+	ARC_INT(type, location.latitude), ARC_RAW(type, location.ns_d), \
+	ARC_INT(type, location.longitude), ARC_RAW(type, location.ew_d)
+
+/*
+*  Column layouts, NMEA_ARCHIVE_VERSION 1. Append only: readers ignore columns
+*  past their layout and step over blocks with fewer columns or other widths,
+*  changing an existing entry needs a version bump.
+*/
+static const Arc_Field_t Arc_DTM[] = {
+	ARC_TEXT(DTM, datum), ARC_TEXT(DTM, subDatum), ARC_RAW(DTM, latOffset), ARC_RAW(DTM, ns_d),
+	ARC_RAW(DTM, lonOffset), ARC_RAW(DTM, ew_d), ARC_RAW(DTM, altOffset), ARC_TEXT(DTM, refDatum),
+};
+
+static const Arc_Field_t Arc_GBS[] = {
+	ARC_TIME(GBS, time), ARC_RAW(GBS, errLat), ARC_RAW(GBS, errLon), ARC_RAW(GBS, errAlt),
+	ARC_RAW(GBS, svid), ARC_RAW(GBS, prob), ARC_RAW(GBS, bias), ARC_RAW(GBS, stddev),
+};
+
+static const Arc_Field_t Arc_GGA[] = {
+	ARC_TIME(GGA, time), ARC_LOCATION(GGA), ARC_RAW(GGA, quality), ARC_RAW(GGA, satellite_n),
+	ARC_RAW(GGA, hdop), ARC_RAW(GGA, altitude), ARC_RAW(GGA, separation), ARC_RAW(GGA, diffAge),
+	ARC_RAW(GGA, diffStation),
+};
+
+static const Arc_Field_t Arc_GLL[] = {
+	ARC_LOCATION(GLL), ARC_TIME(GLL, time), ARC_RAW(GLL, status), ARC_RAW(GLL, posMode),
+};
+
+static const Arc_Field_t Arc_GNS[] = {
+	ARC_TIME(GNS, time), ARC_LOCATION(GNS), ARC_RAW(GNS, posMode), ARC_RAW(GNS, numSV),
+	ARC_RAW(GNS, hdop), ARC_RAW(GNS, altitude), ARC_RAW(GNS, separation), ARC_RAW(GNS, diffAge),
+	ARC_RAW(GNS, diffStation), ARC_RAW(GNS, navStatus),
+};
+
+static const Arc_Field_t Arc_GRS[] = {
+	ARC_TIME(GRS, time), ARC_RAW(GRS, mode), ARC_RAW(GRS, residual_n), ARC_RAW(GRS, residual),
+	ARC_RAW(GRS, systemId), ARC_RAW(GRS, signalId),
+};
+
+static const Arc_Field_t Arc_GSA[] = {
+	ARC_RAW(GSA, opMode), ARC_RAW(GSA, navMode), ARC_RAW(GSA, fix_type), ARC_RAW(GSA, sats),
+	ARC_RAW(GSA, pdop), ARC_RAW(GSA, hdop), ARC_RAW(GSA, vdop),
+};
+
+static const Arc_Field_t Arc_GST[] = {
+	ARC_TIME(GST, time), ARC_RAW(GST, rangeRms), ARC_RAW(GST, stdMajor), ARC_RAW(GST, stdMinor),
+	ARC_RAW(GST, orient), ARC_RAW(GST, stdLat), ARC_RAW(GST, stdLon), ARC_RAW(GST, stdAlt),
+};
+
+static const Arc_Field_t Arc_GSV[] = {
+	ARC_RAW(GSV, numMsg), ARC_RAW(GSV, msgNum), ARC_RAW(GSV, numSV), ARC_RAW(GSV, sats),
+	ARC_RAW(GSV, signalId),
+};
+
+static const Arc_Field_t Arc_RMC[] = {
+	ARC_TIME(RMC, time), ARC_RAW(RMC, status), ARC_LOCATION(RMC), ARC_RAW(RMC, speed),
+	ARC_RAW(RMC, course), ARC_DATE(RMC, date), ARC_RAW(RMC, variation), ARC_RAW(RMC, posMode),
+	ARC_RAW(RMC, navStatus),
+};
+
+static const Arc_Field_t Arc_TXT[] = {
+	ARC_RAW(TXT, numMsg), ARC_RAW(TXT, msgNum), ARC_RAW(TXT, msgType), ARC_TEXT(TXT, text),
+};
+
+static const Arc_Field_t Arc_VLW[] = {
+	ARC_RAW(VLW, twd), ARC_RAW(VLW, wd), ARC_RAW(VLW, tgd), ARC_RAW(VLW, gd),
+};
+
+static const Arc_Field_t Arc_VTG[] = {
+	ARC_RAW(VTG, cogt), ARC_RAW(VTG, cogm), ARC_RAW(VTG, sogn), ARC_RAW(VTG, sogk),
+	ARC_RAW(VTG, posMode),
+};
+
+static const Arc_Field_t Arc_ZDA[] = {
+	ARC_TIME(ZDA, time), ARC_DATE(ZDA, date), ARC_RAW(ZDA, hour_offset), ARC_RAW(ZDA, minute_offset),
+};
+
+#define ARC_LAYOUT(table)	{ table, sizeof(table) / sizeof(table[0]) }
+
+static const Arc_Layout_t Arc_Layout[NMEA_MSG_ZDA + 1] = {
+	[NMEA_MSG_DTM] = ARC_LAYOUT(Arc_DTM),
+	[NMEA_MSG_GBS] = ARC_LAYOUT(Arc_GBS),
+	[NMEA_MSG_GGA] = ARC_LAYOUT(Arc_GGA),
+	[NMEA_MSG_GLL] = ARC_LAYOUT(Arc_GLL),
+	[NMEA_MSG_GNS] = ARC_LAYOUT(Arc_GNS),
+	[NMEA_MSG_GRS] = ARC_LAYOUT(Arc_GRS),
+	[NMEA_MSG_GSA] = ARC_LAYOUT(Arc_GSA),
+	[NMEA_MSG_GST] = ARC_LAYOUT(Arc_GST),
+	[NMEA_MSG_GSV] = ARC_LAYOUT(Arc_GSV),
+	[NMEA_MSG_RMC] = ARC_LAYOUT(Arc_RMC),
+	[NMEA_MSG_TXT] = ARC_LAYOUT(Arc_TXT),
+	[NMEA_MSG_VLW] = ARC_LAYOUT(Arc_VLW),
+	[NMEA_MSG_VTG] = ARC_LAYOUT(Arc_VTG),
+	[NMEA_MSG_ZDA] = ARC_LAYOUT(Arc_ZDA),
+};
+
+static inline const Arc_Layout_t* Arc_Find_Layout(uint8_t payloadId) {
+	if (payloadId > NMEA_MSG_ZDA || !Arc_Layout[payloadId].fields) return NULL;
+	return &Arc_Layout[payloadId];
+}
+
+static inline bool Arc_Field_Raw(const Arc_Field_t* field) {
+	return field->type == ARC_FIELD_RAW || field->type == ARC_FIELD_TEXT;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/* Wrapping difference, every int32_t pair round trips. */
+static inline uint32_t Arc_ZigZag(int32_t value, int32_t previous) {
+	int32_t delta = (int32_t)((uint32_t)value - (uint32_t)previous);
+	return ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+}
+
+static inline int32_t Arc_UnZigZag(uint32_t code, int32_t previous) {
+	int32_t delta = (int32_t)((code >> 1) ^ (~(code & 1) + 1));
+	return (int32_t)((uint32_t)previous + (uint32_t)delta);
+}
+
+static inline size_t Arc_Varint_Put(uint8_t* out, uint32_t value) {
+	size_t n = 0;
+	while (value >= 0x80) {
+		out[n++] = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	out[n++] = (uint8_t)value;
+	return n;
+}
+
+/* Returns 0 past the end of the column or on an over long varint. */
+static inline bool Arc_Varint_Get(const uint8_t** cursor, const uint8_t* end, uint32_t* value) {
+	uint32_t v = 0;
+	for (uint8_t shift = 0; shift < 7 * ARC_VARINT_MAX; shift += 7) {
+		if (*cursor >= end) return false;
+		uint8_t byte = *(*cursor)++;
+		v |= (uint32_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			*value = v;
+			return true;
+		}
+	}
+	return false;
+}
+
+static int32_t Arc_Field_Value(const Arc_Field_t* field, const NMEA_Payload_t* frame) {
+	const uint8_t* member = (const uint8_t*)frame + field->offset;
+
+	switch (field->type) {
+	case ARC_FIELD_TIME: return ((const NMEA_Time_t*)member)->ms;
+	case ARC_FIELD_DATE: {
+		const NMEA_Date_t* date = (const NMEA_Date_t*)member;
+		if (date->year < 0) return -1;
+		return date->year * 10000 + date->month * 100 + date->day;
+	}
+	default: {
+		int32_t value;
+		memcpy(&value, member, sizeof(value));
+		return value;
+	}
+	}
+}
+
+static void Arc_Field_Store(const Arc_Field_t* field, NMEA_Payload_t* frame, int32_t value) {
+	uint8_t* member = (uint8_t*)frame + field->offset;
+
+	switch (field->type) {
+	case ARC_FIELD_TIME: {
+		NMEA_Time_t* time = (NMEA_Time_t*)member;
+		time->ms = value;
+		if (value < 0) {
+			time->hour = -1;
+			time->min = -1;
+			time->sec = -1;
+			break;
+		}
+		time->hour = (int8_t)(value / 3600000);
+		time->min = (int8_t)((value / 60000) % 60);
+		time->sec = (int8_t)((value / 1000) % 60);
+	}break;
+	case ARC_FIELD_DATE: {
+		NMEA_Date_t* date = (NMEA_Date_t*)member;
+		if (value < 0) {
+			date->year = -1;
+			date->month = -1;
+			date->day = -1;
+			break;
+		}
+		date->year = value / 10000;
+		date->month = (value / 100) % 100;
+		date->day = value % 100;
+	}break;
+	default: memcpy(member, &value, sizeof(value)); break;
+	}
+}
+
+static bool Arc_Write(int fd, const void* buf, size_t len) {
+	const uint8_t* p = buf;
+	while (len) {
+		ssize_t n = write(fd, p, len);
+		if (n <= 0) return false;
+		p += n;
+		len -= (size_t)n;
+	}
+	return true;
+}
+
+/**
+* Assembles the block of one payload type in the scratch buffer and writes it
+* with one call. Delta columns are sized after coding, the bound is 5 bytes a row.
+*/
+static bool Arc_Flush(NMEA_ArchiveWriter_t* writer, uint8_t payloadId) {
+
+	const Arc_Layout_t* layout = &Arc_Layout[payloadId];
+	uint32_t rows = writer->count[payloadId];
+	uint8_t columns = (uint8_t)(layout->count + ARC_FIXED_COLUMNS);
+
+	if (!rows || writer->failed) return !writer->failed;
+
+	size_t header = ARC_ALIGN(sizeof(NMEA_ArchiveBlock_t) + columns * sizeof(NMEA_ArchiveColumn_t));
+	size_t bound = header + ARC_ALIGN(rows) + ARC_ALIGN((size_t)rows * ARC_VARINT_MAX);
+	for (uint8_t c = 0; c < layout->count; c++) {
+		size_t width = Arc_Field_Raw(&layout->fields[c]) ? layout->fields[c].width : ARC_VARINT_MAX;
+		bound += ARC_ALIGN((size_t)rows * width);
+	}
+
+	if (bound > writer->scratchSize) {
+		uint8_t* scratch = realloc(writer->scratch, bound);
+		if (scratch == NULL) {
+			writer->failed = true;
+			return false;
+		}
+		writer->scratch = scratch;
+		writer->scratchSize = bound;
+	}
+
+	uint8_t* block = writer->scratch;
+	NMEA_ArchiveColumn_t* directory = (NMEA_ArchiveColumn_t*)(block + sizeof(NMEA_ArchiveBlock_t));
+	size_t pos = header;
+
+	memset(block, 0, header);
+
+	/* Column 0, talker IDs. */
+	directory[0].encoding = NMEA_ARCHIVE_RAW;
+	directory[0].width = 1;
+	directory[0].offset = (uint32_t)pos;
+	directory[0].size = rows;
+	memcpy(&block[pos], writer->talkerId[payloadId], rows);
+	pos = ARC_ALIGN(pos + rows);
+
+	/* Column 1, file wide row sequence. */
+	int32_t previous = 0;
+	directory[1].encoding = NMEA_ARCHIVE_DELTA;
+	directory[1].width = 4;
+	directory[1].offset = (uint32_t)pos;
+	for (uint32_t r = 0; r < rows; r++) {
+		int32_t value = (int32_t)writer->rowSequence[payloadId][r];
+		pos += Arc_Varint_Put(&block[pos], Arc_ZigZag(value, previous));
+		previous = value;
+	}
+	directory[1].size = (uint32_t)(pos - directory[1].offset);
+	size_t end = pos;
+	pos = ARC_ALIGN(pos);
+	memset(&block[end], 0, pos - end);
+
+	const NMEA_Payload_t* frames = writer->frames[payloadId];
+
+	for (uint8_t c = 0; c < layout->count; c++) {
+		const Arc_Field_t* field = &layout->fields[c];
+		NMEA_ArchiveColumn_t* column = &directory[c + ARC_FIXED_COLUMNS];
+
+		column->offset = (uint32_t)pos;
+		column->width = field->width;
+
+		if (Arc_Field_Raw(field)) {
+			column->encoding = NMEA_ARCHIVE_RAW;
+			for (uint32_t r = 0; r < rows; r++) {
+				memcpy(&block[pos], (const uint8_t*)&frames[r] + field->offset, field->width);
+				pos += field->width;
+			}
+		}
+		else {
+			column->encoding = NMEA_ARCHIVE_DELTA;
+			previous = 0;
+			for (uint32_t r = 0; r < rows; r++) {
+				int32_t value = Arc_Field_Value(field, &frames[r]);
+				pos += Arc_Varint_Put(&block[pos], Arc_ZigZag(value, previous));
+				previous = value;
+			}
+		}
+
+		column->size = (uint32_t)(pos - column->offset);
+		end = pos;
+		pos = ARC_ALIGN(pos);
+		memset(&block[end], 0, pos - end);
+	}
+
+	NMEA_ArchiveBlock_t* head = (NMEA_ArchiveBlock_t*)block;
+	head->size = (uint32_t)pos;
+	head->rows = rows;
+	head->payloadId = payloadId;
+	head->columns = columns;
+
+	writer->count[payloadId] = 0;
+
+	if (!Arc_Write(writer->fd, block, pos)) {
+		writer->failed = true;
+		return false;
+	}
+	return true;
+}
+
+bool NMEA_Archive_Create(NMEA_ArchiveWriter_t* writer, const char* path) {
+
+	memset(writer, 0, sizeof(NMEA_ArchiveWriter_t));
+
+	writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (writer->fd < 0) return false;
+
+	NMEA_ArchiveHeader_t header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "NMAR", 4);
+	header.version = NMEA_ARCHIVE_VERSION;
+	header.byteOrder = 0x0102;
+	header.blockRows = NMEA_ARCHIVE_BLOCK_ROWS;
+
+	if (!Arc_Write(writer->fd, &header, sizeof(header))) {
+		close(writer->fd);
+		writer->fd = -1;
+		return false;
+	}
+	return true;
+}
+
+bool NMEA_Archive_Add(NMEA_ArchiveWriter_t* writer, uint8_t talkerId, uint8_t payloadId, const NMEA_Payload_t* frame) {
+
+	if (writer->failed || !Arc_Find_Layout(payloadId)) return false;
+
+	if (writer->frames[payloadId] == NULL) {
+		writer->frames[payloadId] = malloc(NMEA_ARCHIVE_BLOCK_ROWS * sizeof(NMEA_Payload_t));
+		writer->talkerId[payloadId] = malloc(NMEA_ARCHIVE_BLOCK_ROWS);
+		writer->rowSequence[payloadId] = malloc(NMEA_ARCHIVE_BLOCK_ROWS * sizeof(uint32_t));
+
+		if (!writer->frames[payloadId] || !writer->talkerId[payloadId] || !writer->rowSequence[payloadId]) {
+			writer->failed = true;
+			return false;
+		}
+	}
+
+	uint32_t row = writer->count[payloadId]++;
+	writer->frames[payloadId][row] = *frame;
+	writer->talkerId[payloadId][row] = talkerId;
+	writer->rowSequence[payloadId][row] = writer->sequence++;
+
+	if (writer->count[payloadId] == NMEA_ARCHIVE_BLOCK_ROWS) return Arc_Flush(writer, payloadId);
+	return true;
+}
+
+size_t NMEA_Archive_AddRecords(NMEA_ArchiveWriter_t* writer, const NMEA_Record_t* records, size_t count) {
+	size_t added = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (NMEA_Archive_Add(writer, records[i].talkerId, records[i].payloadId, &records[i].payload)) added++;
+	}
+	return added;
+}
+
+bool NMEA_Archive_Finish(NMEA_ArchiveWriter_t* writer) {
+
+	for (uint8_t id = 0; id <= NMEA_MSG_ZDA; id++) {
+		if (writer->count[id]) Arc_Flush(writer, id);
+
+		free(writer->frames[id]);
+		free(writer->talkerId[id]);
+		free(writer->rowSequence[id]);
+		writer->frames[id] = NULL;
+		writer->talkerId[id] = NULL;
+		writer->rowSequence[id] = NULL;
+	}
+
+	free(writer->scratch);
+	writer->scratch = NULL;
+	writer->scratchSize = 0;
+
+	if (writer->fd >= 0 && close(writer->fd) != 0) writer->failed = true;
+	writer->fd = -1;
+
+	return !writer->failed;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/* Block and directory inside the file, every column inside the block. */
+static bool Arc_Block_Sound(const NMEA_ArchiveBlock_t* block, size_t available) {
+
+	if (available < sizeof(NMEA_ArchiveBlock_t)) return false;
+	if (block->size < sizeof(NMEA_ArchiveBlock_t) || block->size > available || block->size % 8) return false;
+	if (sizeof(NMEA_ArchiveBlock_t) + block->columns * sizeof(NMEA_ArchiveColumn_t) > block->size) return false;
+
+	const NMEA_ArchiveColumn_t* directory = (const NMEA_ArchiveColumn_t*)(block + 1);
+
+	for (uint8_t c = 0; c < block->columns; c++) {
+		const NMEA_ArchiveColumn_t* column = &directory[c];
+
+		if (column->encoding != NMEA_ARCHIVE_RAW && column->encoding != NMEA_ARCHIVE_DELTA) return false;
+		if (column->offset % 8 || (uint64_t)column->offset + column->size > block->size) return false;
+		if (column->encoding == NMEA_ARCHIVE_RAW && column->size != (uint64_t)block->rows * column->width) return false;
+	}
+	return true;
+}
+
+/* The columns of this build's layout match, text columns may be of another width. */
+static bool Arc_Block_Layout(const NMEA_ArchiveBlock_t* block) {
+
+	const Arc_Layout_t* layout = Arc_Find_Layout(block->payloadId);
+	if (layout == NULL || block->columns < layout->count + ARC_FIXED_COLUMNS) return false;
+
+	const NMEA_ArchiveColumn_t* directory = (const NMEA_ArchiveColumn_t*)(block + 1);
+
+	for (uint8_t c = 0; c < layout->count + ARC_FIXED_COLUMNS; c++) {
+		const NMEA_ArchiveColumn_t* column = &directory[c];
+		const Arc_Field_t* field = NULL;
+		uint8_t encoding;
+		uint16_t width;
+
+		if (c == 0) { encoding = NMEA_ARCHIVE_RAW; width = 1; }
+		else if (c == 1) { encoding = NMEA_ARCHIVE_DELTA; width = 4; }
+		else {
+			field = &layout->fields[c - ARC_FIXED_COLUMNS];
+			encoding = Arc_Field_Raw(field) ? NMEA_ARCHIVE_RAW : NMEA_ARCHIVE_DELTA;
+			width = field->width;
+		}
+
+		if (column->encoding != encoding) return false;
+		if (column->width != width && !(field && field->type == ARC_FIELD_TEXT)) return false;
+	}
+	return true;
+}
+
+bool NMEA_Archive_Open(NMEA_Archive_t* arc, const char* path) {
+
+	struct stat info;
+
+	memset(arc, 0, sizeof(NMEA_Archive_t));
+
+	arc->fd = open(path, O_RDONLY);
+	if (arc->fd < 0) return false;
+
+	if (fstat(arc->fd, &info) != 0 || (size_t)info.st_size < sizeof(NMEA_ArchiveHeader_t)) {
+		close(arc->fd);
+		arc->fd = -1;
+		return false;
+	}
+
+	arc->size = (size_t)info.st_size;
+	void* data = mmap(NULL, arc->size, PROT_READ, MAP_PRIVATE, arc->fd, 0);
+	if (data == MAP_FAILED) {
+		close(arc->fd);
+		arc->fd = -1;
+		return false;
+	}
+	arc->data = data;
+
+	const NMEA_ArchiveHeader_t* header = data;
+	if (memcmp(header->magic, "NMAR", 4) != 0 || header->version != NMEA_ARCHIVE_VERSION || header->byteOrder != 0x0102) {
+		NMEA_Archive_Close(arc);
+		return false;
+	}
+
+	/* Two passes: count, then index. */
+	for (uint8_t pass = 0; pass < 2; pass++) {
+		size_t pos = sizeof(NMEA_ArchiveHeader_t);
+		size_t count = 0;
+		size_t skipped = 0;
+
+		while (pos < arc->size) {
+			const NMEA_ArchiveBlock_t* block = (const NMEA_ArchiveBlock_t*)&arc->data[pos];
+			if (!Arc_Block_Sound(block, arc->size - pos)) {
+				arc->truncated = true;
+				break;
+			}
+			pos += block->size;
+
+			/* Another build's layout, the blocks after it are still indexed. */
+			if (!Arc_Block_Layout(block)) {
+				skipped++;
+				continue;
+			}
+			if (pass) arc->blocks[count] = block;
+			count++;
+		}
+		arc->skipped = skipped;
+
+		if (!pass) {
+			arc->blocks = malloc((count ? count : 1) * sizeof(NMEA_ArchiveBlock_t*));
+			if (arc->blocks == NULL) {
+				NMEA_Archive_Close(arc);
+				return false;
+			}
+		}
+		arc->blockCount = count;
+	}
+
+	madvise(data, arc->size, MADV_WILLNEED);
+	return true;
+}
+
+void NMEA_Archive_Close(NMEA_Archive_t* arc) {
+	if (arc->data) munmap((void*)arc->data, arc->size);
+	if (arc->fd >= 0) close(arc->fd);
+	free(arc->blocks);
+
+	arc->data = NULL;
+	arc->size = 0;
+	arc->fd = -1;
+	arc->blocks = NULL;
+	arc->blockCount = 0;
+	arc->skipped = 0;
+}
+
+int NMEA_Archive_FindColumn(uint8_t payloadId, const char* name) {
+
+	if (strcmp(name, "talkerId") == 0) return 0;
+	if (strcmp(name, "sequence") == 0) return 1;
+
+	const Arc_Layout_t* layout = Arc_Find_Layout(payloadId);
+	if (layout == NULL) return -1;
+
+	for (uint8_t c = 0; c < layout->count; c++) {
+		if (strcmp(layout->fields[c].name, name) == 0) return c + ARC_FIXED_COLUMNS;
+	}
+	return -1;
+}
+
+static const NMEA_ArchiveColumn_t* Arc_Column(const NMEA_Archive_t* arc, size_t block, uint8_t column) {
+	if (block >= arc->blockCount || column >= arc->blocks[block]->columns) return NULL;
+	return &((const NMEA_ArchiveColumn_t*)(arc->blocks[block] + 1))[column];
+}
+
+const void* NMEA_Archive_Column(const NMEA_Archive_t* arc, size_t block, uint8_t column, uint16_t* width) {
+	const NMEA_ArchiveColumn_t* entry = Arc_Column(arc, block, column);
+	if (entry == NULL || entry->encoding != NMEA_ARCHIVE_RAW) return NULL;
+
+	if (width) *width = entry->width;
+	return (const uint8_t*)arc->blocks[block] + entry->offset;
+}
+
+bool NMEA_Archive_Decode(const NMEA_Archive_t* arc, size_t block, uint8_t column, int32_t* out) {
+	const NMEA_ArchiveColumn_t* entry = Arc_Column(arc, block, column);
+	if (entry == NULL || entry->encoding != NMEA_ARCHIVE_DELTA) return false;
+
+	const uint8_t* cursor = (const uint8_t*)arc->blocks[block] + entry->offset;
+	const uint8_t* end = cursor + entry->size;
+	int32_t previous = 0;
+
+	for (uint32_t r = 0; r < arc->blocks[block]->rows; r++) {
+		uint32_t code;
+		if (!Arc_Varint_Get(&cursor, end, &code)) return false;
+		previous = Arc_UnZigZag(code, previous);
+		out[r] = previous;
+	}
+	return true;
+}
+
+bool NMEA_Archive_Read(const NMEA_Archive_t* arc, size_t block, NMEA_Payload_t* frames, uint8_t* talkerId, uint32_t* sequence) {
+
+	if (block >= arc->blockCount) return false;
+
+	const NMEA_ArchiveBlock_t* head = arc->blocks[block];
+	const NMEA_ArchiveColumn_t* directory = (const NMEA_ArchiveColumn_t*)(head + 1);
+	const Arc_Layout_t* layout = &Arc_Layout[head->payloadId];
+	const uint8_t* base = (const uint8_t*)head;
+	uint32_t rows = head->rows;
+
+	memset(frames, 0, rows * sizeof(NMEA_Payload_t));
+
+	if (talkerId) memcpy(talkerId, base + directory[0].offset, rows);
+
+	for (uint8_t c = 1; c < layout->count + ARC_FIXED_COLUMNS; c++) {
+		const NMEA_ArchiveColumn_t* column = &directory[c];
+		const Arc_Field_t* field = (c >= ARC_FIXED_COLUMNS) ? &layout->fields[c - ARC_FIXED_COLUMNS] : NULL;
+		const uint8_t* cursor = base + column->offset;
+
+		if (column->encoding == NMEA_ARCHIVE_RAW) {
+			/* A wider text column of another build is cut, still NUL terminated. */
+			uint16_t width = (column->width < field->width) ? column->width : field->width;
+			for (uint32_t r = 0; r < rows; r++, cursor += column->width) {
+				uint8_t* member = (uint8_t*)&frames[r] + field->offset;
+				memcpy(member, cursor, width);
+				if (column->width > field->width) member[field->width - 1] = '\0';
+			}
+			continue;
+		}
+
+		if (!field && !sequence) continue;
+
+		const uint8_t* end = cursor + column->size;
+		int32_t previous = 0;
+
+		for (uint32_t r = 0; r < rows; r++) {
+			uint32_t code;
+			if (!Arc_Varint_Get(&cursor, end, &code)) return false;
+			previous = Arc_UnZigZag(code, previous);
+
+			if (field) Arc_Field_Store(field, &frames[r], previous);
+			else sequence[r] = (uint32_t)previous;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,151 @@
+/*
+ *	nmea_archive.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Binary columnar archive of parsed payload structs, written once after the
+ *  text ingest and mapped read-only afterwards. POSIX hosts, like nmea_log.
+ *
+ *  File   : NMEA_ArchiveHeader_t, then blocks back to back.
+ *  Block  : NMEA_ArchiveBlock_t, column directory, column data. One payload
+ *           type per block, up to NMEA_ARCHIVE_BLOCK_ROWS rows, every column
+ *           starts 8 byte aligned.
+ *  Column : NMEA_ARCHIVE_RAW columns hold the struct member bytes of each row
+ *           and are read in place. NMEA_ARCHIVE_DELTA columns hold int32
+ *           values (time in ms, date as yyyymmdd, location, sequence) as
+ *           zigzag varints of the difference to the previous row.
+ *
+ *  Column 0 is the talker ID, column 1 the sequence number of the row among
+ *  all rows of the file; the payload members follow in a fixed per-type
+ *  order, NMEA_Archive_FindColumn looks them up by member name.
+ *
+ *  16.10.2026 : File is created.
+ *  16.10.2026 : Blocks of another column layout are skipped, text columns of another width are read.
+ *
+ */
+
+#ifndef NMEA_ARCHIVE_H_
+#define NMEA_ARCHIVE_H_
+
+#include "nmea.h"
+#include "nmea_log.h"
+
+#define NMEA_ARCHIVE_VERSION		1
+#define NMEA_ARCHIVE_BLOCK_ROWS		4096		// Rows buffered per payload type before a block is written
+
+typedef enum {
+	NMEA_ARCHIVE_RAW = 0,
+	NMEA_ARCHIVE_DELTA,
+}NMEA_archiveEncoding_e;
+
+/*
+*  On-disk structures, native byte order (checked against byteOrder on open).
+*/
+typedef struct NMEA_ArchiveHeader_s {
+	char magic[4];			// "NMAR"
+	uint16_t version;
+	uint16_t byteOrder;		// 0x0102 as written by the host
+	uint32_t blockRows;
+	uint32_t reserved;
+}NMEA_ArchiveHeader_t;
+
+typedef struct NMEA_ArchiveBlock_s {
+	uint32_t size;			// Whole block, header to the end of the last column
+	uint32_t rows;
+	uint8_t payloadId;
+	uint8_t columns;
+	uint16_t reserved;
+	uint32_t reserved2;
+}NMEA_ArchiveBlock_t;
+
+typedef struct NMEA_ArchiveColumn_s {
+	uint8_t encoding;		// NMEA_archiveEncoding_e
+	uint8_t reserved;
+	uint16_t width;			// Bytes per row of a raw column, 4 for delta
+	uint32_t offset;		// From the block start
+	uint32_t size;
+}NMEA_ArchiveColumn_t;
+
+/*
+*  Writer. Row buffers of a payload type are allocated on its first row.
+*/
+typedef struct NMEA_ArchiveWriter_s {
+	int fd;
+	bool failed;			// A write or allocation failed, the file is incomplete
+	uint32_t sequence;		// Rows added
+
+	uint32_t count[NMEA_MSG_ZDA + 1];
+	uint8_t* talkerId[NMEA_MSG_ZDA + 1];
+	uint32_t* rowSequence[NMEA_MSG_ZDA + 1];
+	NMEA_Payload_t* frames[NMEA_MSG_ZDA + 1];
+
+	uint8_t* scratch;		// Block assembly buffer
+	size_t scratchSize;
+}NMEA_ArchiveWriter_t;
+
+/*
+*  Mapped archive.
+*/
+typedef struct NMEA_Archive_s {
+	const uint8_t* data;
+	size_t size;
+	int fd;
+
+	const NMEA_ArchiveBlock_t** blocks;		// Valid blocks in file order
+	size_t blockCount;
+	size_t skipped;			// Blocks of another column layout, stepped over
+	bool truncated;			// Indexing stopped at a damaged or partial block
+}NMEA_Archive_t;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+/* Creates / truncates the file and writes the header. */
+bool NMEA_Archive_Create(NMEA_ArchiveWriter_t* writer, const char* path);
+
+/**
+ * Buffers one parsed frame, writes the block of its payload type when full.
+ * Returns 0 for payload types without a parser, or after a write failure.
+ */
+bool NMEA_Archive_Add(NMEA_ArchiveWriter_t* writer, uint8_t talkerId, uint8_t payloadId, const NMEA_Payload_t* frame);
+
+/* NMEA_Log_ParseParallel output. Returns the number of records added. */
+size_t NMEA_Archive_AddRecords(NMEA_ArchiveWriter_t* writer, const NMEA_Record_t* records, size_t count);
+
+/* Writes the partial blocks and closes the file. Returns 0 if anything failed. */
+bool NMEA_Archive_Finish(NMEA_ArchiveWriter_t* writer);
+
+/**
+ * Maps an archive and indexes its blocks. Files of another layout version
+ * or byte order are refused. Blocks whose columns don't match this build
+ * (fewer columns, other member widths) are stepped over by size and counted
+ * in arc->skipped; text columns (TXT text, DTM datums) may be of any width and
+ * are cut to this build's member. A damaged or partial tail stops the index
+ * and sets arc->truncated. Returns 0 if the file can't be mapped or isn't an archive.
+ */
+bool NMEA_Archive_Open(NMEA_Archive_t* arc, const char* path);
+void NMEA_Archive_Close(NMEA_Archive_t* arc);
+
+/* Column index of a payload member ("time", "location.latitude", ...), -1 if none. */
+int NMEA_Archive_FindColumn(uint8_t payloadId, const char* name);
+
+/**
+ * Raw column data in place, rows * width bytes, valid until NMEA_Archive_Close.
+ * Returns NULL for delta columns.
+ */
+const void* NMEA_Archive_Column(const NMEA_Archive_t* arc, size_t block, uint8_t column, uint16_t* width);
+
+/**
+ * Decodes a delta column to one int32_t per row.
+ * Returns 0 for raw columns or a malformed column.
+ */
+bool NMEA_Archive_Decode(const NMEA_Archive_t* arc, size_t block, uint8_t column, int32_t* out);
+
+/**
+ * Rebuilds the payload structs of a block, rows entries each. Unused bytes of
+ * the frames are zeroed. talkerId / sequence may be NULL.
+ * Returns 0 on a malformed block.
+ */
+bool NMEA_Archive_Read(const NMEA_Archive_t* arc, size_t block, NMEA_Payload_t* frames, uint8_t* talkerId, uint32_t* sequence);
+
+#endif /* NMEA_ARCHIVE_H_ */
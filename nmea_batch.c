@@ -0,0 +1,280 @@
+/*
+ *	nmea_batch.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Batch decoder for NMEA logs. A buffer of many sentences is parsed into
+ *  struct-of-arrays columns, one column set per payload type.
+ *
+ *  16.10.2026 : File is created. GBS, GGA, GLL, GSA, GST, RMC, VTG, ZDA columns.
+ *
+ *  16.10.2026 : GGA HDOP, altitude, separation & differential columns.
+ *
+ *  16.10.2026 : Lines end at CR or LF. Retried sentences are counted once.
+ *
+ *  16.10.2026 : GNS & VLW columns, empty ZDA date is -1, a '$' inside a line restarts it.
+ *
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "nmea_batch.h"
+
+static int32_t NMEA_Batch_Time(const NMEA_Time_t* time) {
+	return time->ms;
+}
+
+static int32_t NMEA_Batch_Date(const NMEA_Date_t* date) {
+	if (date->year < 0) return -1;
+	return date->year * 10000 + date->month * 100 + date->day;
+}
+
+/* ZDA date fields are plain integers, empty ones read 0 and no date has day 0. */
+static int32_t NMEA_Batch_ZdaDate(const NMEA_Date_t* date) {
+	if (date->day == 0 || date->month == 0) return -1;
+	return NMEA_Batch_Date(date);
+}
+
+static int32_t NMEA_Batch_Signed(int32_t value, int8_t direction) {
+	if (value < 0) return value;	// Empty field
+	return (direction < 0) ? -value : value;
+}
+
+void NMEA_Batch_Init(NMEA_Batch_t* batch) {
+	NMEA_Parser_Init(&batch->parser);
+	batch->skipped = 0;
+	NMEA_Batch_Clear(batch);
+}
+
+void NMEA_Batch_Clear(NMEA_Batch_t* batch) {
+	batch->gbs.count = 0;
+	batch->gga.count = 0;
+	batch->gll.count = 0;
+	batch->gns.count = 0;
+	batch->gsa.count = 0;
+	batch->gst.count = 0;
+	batch->rmc.count = 0;
+	batch->vlw.count = 0;
+	batch->vtg.count = 0;
+	batch->zda.count = 0;
+}
+
+/**
+* Appends one packed sentence to its column set.
+* Returns 0 if the column set is full, the sentence is not consumed.
+*/
+static bool NMEA_Batch_Row(NMEA_Batch_t* batch, const NMEA_Message_t* msg) {
+	uint32_t i;
+
+	switch (msg->payloadId) {
+	case(NMEA_MSG_GBS): {
+		NMEA_Columns_GBS_t* col = &batch->gbs;
+		NMEA_Payload_GBS_t frame = { 0 };
+		if (col->count == NMEA_BATCH_LEN) return false;
+		if (!NMEA_GBS_Parse(&frame, msg)) break;
+
+		i = col->count++;
+		col->talkerId[i] = msg->talkerId;
+		col->time[i] = NMEA_Batch_Time(&frame.time);
+		col->errLat[i] = frame.errLat;
+		col->errLon[i] = frame.errLon;
+		col->errAlt[i] = frame.errAlt;
+		col->svid[i] = frame.svid;
+		col->prob[i] = frame.prob;
+		col->bias[i] = frame.bias;
+		col->stddev[i] = frame.stddev;
+	} return true;
+
+	case(NMEA_MSG_GGA): {
+		NMEA_Columns_GGA_t* col = &batch->gga;
+		NMEA_Payload_GGA_t frame = { 0 };
+		if (col->count == NMEA_BATCH_LEN) return false;
+		if (!NMEA_GGA_Parse(&frame, msg)) break;
+
+		i = col->count++;
+		col->talkerId[i] = msg->talkerId;
+		col->time[i] = NMEA_Batch_Time(&frame.time);
+		col->latitude[i] = NMEA_Batch_Signed(frame.location.latitude, frame.location.ns_d);
+		col->longitude[i] = NMEA_Batch_Signed(frame.location.longitude, frame.location.ew_d);
+		col->quality[i] = frame.quality;
+		col->satellite_n[i] = frame.satellite_n;
+		col->hdop[i] = frame.hdop;
+		col->altitude[i] = frame.altitude;
+		col->separation[i] = frame.separation;
+		col->diffAge[i] = frame.diffAge;
+		col->diffStation[i] = frame.diffStation;
+	} return true;
+
+	case(NMEA_MSG_GLL): {
+		NMEA_Columns_GLL_t* col = &batch->gll;
+		NMEA_Payload_GLL_t frame = { 0 };
+		if (col->count == NMEA_BATCH_LEN) return false;
+		if (!NMEA_GLL_Parse(&frame, msg)) break;
+
+		i = col->count++;
+		col->talkerId[i] = msg->talkerId;
+		col->time[i] = NMEA_Batch_Time(&frame.time);
+		col->latitude[i] = NMEA_Batch_Signed(frame.location.latitude, frame.location.ns_d);
+		col->longitude[i] = NMEA_Batch_Signed(frame.location.longitude, frame.location.ew_d);
+		col->status[i] = frame.status;
+		col->posMode[i] = frame.posMode;
+	} return true;
+
+	case(NMEA_MSG_GNS): {
+		NMEA_Columns_GNS_t* col = &batch->gns;
+		NMEA_Payload_GNS_t frame = { 0 };
+		if (col->count == NMEA_BATCH_LEN) return false;
+		if (!NMEA_GNS_Parse(&frame, msg)) break;
+
+		i = col->count++;
+		col->talkerId[i] = msg->talkerId;
+		col->time[i] = NMEA_Batch_Time(&frame.time);
+		col->latitude[i] = NMEA_Batch_Signed(frame.location.latitude, frame.location.ns_d);
+		col->longitude[i] = NMEA_Batch_Signed(frame.location.longitude, frame.location.ew_d);
+		memcpy(col->posMode[i], frame.posMode, sizeof(frame.posMode));
+		col->numSV[i] = frame.numSV;
+		col->hdop[i] = frame.hdop;
+		col->altitude[i] = frame.altitude;
+		col->separation[i] = frame.separation;
+		col->diffAge[i] = frame.diffAge;
+		col->diffStation[i] = frame.diffStation;
+		col->navStatus[i] = frame.navStatus;
+	} return true;
+
+	case(NMEA_MSG_GSA): {
+		NMEA_Columns_GSA_t* col = &batch->gsa;
+		NMEA_Payload_GSA_t frame = { 0 };
+		if (col->count == NMEA_BATCH_LEN) return false;
+		if (!NMEA_GSA_Parse(&frame, msg)) break;
+
+		i = col->count++;
+		col->talkerId[i] = msg->talkerId;
+		col->opMode[i] = frame.opMode;
+		col->navMode[i] = frame.navMode;
+		col->fix_type[i] = frame.fix_type;
+		col->pdop[i] = frame.pdop;
+		col->hdop[i] = frame.hdop;
+		col->vdop[i] = frame.vdop;
+	} return true;
+
+	case(NMEA_MSG_GST): {
+		NMEA_Columns_GST_t* col = &batch->gst;
+		NMEA_Payload_GST_t frame = { 0 };
+		if (col->count == NMEA_BATCH_LEN) return false;
+		if (!NMEA_GST_Parse(&frame, msg)) break;
+
+		i = col->count++;
+		col->talkerId[i] = msg->talkerId;
+		col->time[i] = NMEA_Batch_Time(&frame.time);
+		col->rangeRms[i] = frame.rangeRms;
+		col->stdMajor[i] = frame.stdMajor;
+		col->stdMinor[i] = frame.stdMinor;
+		col->orient[i] = frame.orient;
+		col->stdLat[i] = frame.stdLat;
+		col->stdLon[i] = frame.stdLon;
+		col->stdAlt[i] = frame.stdAlt;
+	} return true;
+
+	case(NMEA_MSG_RMC): {
+		NMEA_Columns_RMC_t* col = &batch->rmc;
+		NMEA_Payload_RMC_t frame = { 0 };
+		if (col->count == NMEA_BATCH_LEN) return false;
+		if (!NMEA_RMC_Parse(&frame, msg)) break;
+
+		i = col->count++;
+		col->talkerId[i] = msg->talkerId;
+		col->time[i] = NMEA_Batch_Time(&frame.time);
+		col->status[i] = frame.status;
+		col->latitude[i] = NMEA_Batch_Signed(frame.location.latitude, frame.location.ns_d);
+		col->longitude[i] = NMEA_Batch_Signed(frame.location.longitude, frame.location.ew_d);
+		col->speed[i] = frame.speed;
+		col->course[i] = frame.course;
+		col->date[i] = NMEA_Batch_Date(&frame.date);
+		col->variation[i] = frame.variation;
+		col->posMode[i] = frame.posMode;
+	} return true;
+
+	case(NMEA_MSG_VLW): {
+		NMEA_Columns_VLW_t* col = &batch->vlw;
+		NMEA_Payload_VLW_t frame = { 0 };
+		if (col->count == NMEA_BATCH_LEN) return false;
+		if (!NMEA_VLW_Parse(&frame, msg)) break;
+
+		i = col->count++;
+		col->talkerId[i] = msg->talkerId;
+		col->twd[i] = frame.twd;
+		col->wd[i] = frame.wd;
+		col->tgd[i] = frame.tgd;
+		col->gd[i] = frame.gd;
+	} return true;
+
+	case(NMEA_MSG_VTG): {
+		NMEA_Columns_VTG_t* col = &batch->vtg;
+		NMEA_Payload_VTG_t frame = { 0 };
+		if (col->count == NMEA_BATCH_LEN) return false;
+		if (!NMEA_VTG_Parse(&frame, msg)) break;
+
+		i = col->count++;
+		col->talkerId[i] = msg->talkerId;
+		col->cogt[i] = frame.cogt;
+		col->cogm[i] = frame.cogm;
+		col->sogn[i] = frame.sogn;
+		col->sogk[i] = frame.sogk;
+		col->posMode[i] = frame.posMode;
+	} return true;
+
+	case(NMEA_MSG_ZDA): {
+		NMEA_Columns_ZDA_t* col = &batch->zda;
+		NMEA_Payload_ZDA_t frame = { 0 };
+		if (col->count == NMEA_BATCH_LEN) return false;
+		if (!NMEA_ZDA_Parse(&frame, msg)) break;
+
+		i = col->count++;
+		col->talkerId[i] = msg->talkerId;
+		col->time[i] = NMEA_Batch_Time(&frame.time);
+		col->date[i] = NMEA_Batch_ZdaDate(&frame.date);
+		col->hour_offset[i] = frame.hour_offset;
+		col->minute_offset[i] = frame.minute_offset;
+	} return true;
+
+	default: {
+	}break;
+	}
+
+	batch->skipped++;
+	return true;
+}
+
+size_t NMEA_ParseBatch(NMEA_Batch_t* batch, const uint8_t* buf, size_t len) {
+
+	const uint8_t* limit = buf + len;
+	size_t pos = 0;
+
+	while (pos < len) {
+		const uint8_t* start = memchr(&buf[pos], '$', len - pos);
+		if (start == NULL) return len;			// Only garbage left.
+
+		/* CR or LF ends the line and a later '$' restarts it, like NMEA_Feed. */
+		const uint8_t* end = start + 1;
+		while (end < limit && *end != '\r' && *end != '\n') {
+			if (*end == '$') start = end;
+			end++;
+		}
+		if (end == limit) return (size_t)(start - buf);	// Incomplete last line.
+
+		NMEA_Message_t msg;
+		if (NMEA_Parser_Pack(&batch->parser, &msg, start)) {
+			if (!NMEA_Batch_Row(batch, &msg)) {
+				batch->parser.packed--;		// Packed and counted again by the next call.
+				return (size_t)(start - buf);
+			}
+		}
+
+		pos = (size_t)(end - buf) + 1;
+	}
+
+	return pos;
+}
@@ -0,0 +1,194 @@
+/*
+ *	nmea_batch.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Batch decoder for NMEA logs. A buffer of many sentences is parsed into
+ *  struct-of-arrays columns, one column set per payload type.
+ *
+ *  16.10.2026 : File is created. GBS, GGA, GLL, GSA, GST, RMC, VTG, ZDA columns.
+ *
+ *  16.10.2026 : GGA HDOP, altitude, separation & differential columns.
+ *
+ *  16.10.2026 : Lines end at CR or LF. Retried sentences are counted once.
+ *
+ *  16.10.2026 : GNS & VLW columns, empty ZDA date is -1, a '$' inside a line restarts it.
+ *
+ */
+
+#ifndef NMEA_BATCH_H_
+#define NMEA_BATCH_H_
+
+#include "nmea.h"
+
+#ifndef NMEA_BATCH_LEN
+#define NMEA_BATCH_LEN		256		// Rows per column set.
+#endif
+
+/*
+*  Column conventions:
+*  time      : milliseconds since midnight, -1 if empty.
+*  latitude  : NMEA_Location_t scale, signed by the N/S direction.
+*  longitude : NMEA_Location_t scale, signed by the E/W direction.
+*  date      : NMEA_Date_t packed as yyyymmdd, -1 if empty.
+*
+*  DTM, GRS and TXT have no column set: datum names, residual arrays and text
+*  don't fit a column. Those sentences are counted in skipped, parse them with
+*  NMEA_Parse or NMEA_Dispatch.
+*/
+typedef struct NMEA_Columns_GBS_s {
+	uint32_t count;
+	uint8_t talkerId[NMEA_BATCH_LEN];
+	int32_t time[NMEA_BATCH_LEN];
+	float errLat[NMEA_BATCH_LEN];
+	float errLon[NMEA_BATCH_LEN];
+	float errAlt[NMEA_BATCH_LEN];
+	int32_t svid[NMEA_BATCH_LEN];
+	float prob[NMEA_BATCH_LEN];
+	float bias[NMEA_BATCH_LEN];
+	float stddev[NMEA_BATCH_LEN];
+}NMEA_Columns_GBS_t;
+
+typedef struct NMEA_Columns_GGA_s {
+	uint32_t count;
+	uint8_t talkerId[NMEA_BATCH_LEN];
+	int32_t time[NMEA_BATCH_LEN];
+	int32_t latitude[NMEA_BATCH_LEN];
+	int32_t longitude[NMEA_BATCH_LEN];
+	uint8_t quality[NMEA_BATCH_LEN];
+	uint8_t satellite_n[NMEA_BATCH_LEN];
+	float hdop[NMEA_BATCH_LEN];
+	float altitude[NMEA_BATCH_LEN];
+	float separation[NMEA_BATCH_LEN];
+	float diffAge[NMEA_BATCH_LEN];
+	int32_t diffStation[NMEA_BATCH_LEN];
+}NMEA_Columns_GGA_t;
+
+typedef struct NMEA_Columns_GLL_s {
+	uint32_t count;
+	uint8_t talkerId[NMEA_BATCH_LEN];
+	int32_t time[NMEA_BATCH_LEN];
+	int32_t latitude[NMEA_BATCH_LEN];
+	int32_t longitude[NMEA_BATCH_LEN];
+	char status[NMEA_BATCH_LEN];
+	char posMode[NMEA_BATCH_LEN];
+}NMEA_Columns_GLL_t;
+
+typedef struct NMEA_Columns_GNS_s {
+	uint32_t count;
+	uint8_t talkerId[NMEA_BATCH_LEN];
+	int32_t time[NMEA_BATCH_LEN];
+	int32_t latitude[NMEA_BATCH_LEN];
+	int32_t longitude[NMEA_BATCH_LEN];
+	char posMode[NMEA_BATCH_LEN][NMEA_GNS_MODES + 1];
+	uint8_t numSV[NMEA_BATCH_LEN];
+	float hdop[NMEA_BATCH_LEN];
+	float altitude[NMEA_BATCH_LEN];
+	float separation[NMEA_BATCH_LEN];
+	float diffAge[NMEA_BATCH_LEN];
+	int32_t diffStation[NMEA_BATCH_LEN];
+	char navStatus[NMEA_BATCH_LEN];
+}NMEA_Columns_GNS_t;
+
+typedef struct NMEA_Columns_GSA_s {
+	uint32_t count;
+	uint8_t talkerId[NMEA_BATCH_LEN];
+	char opMode[NMEA_BATCH_LEN];
+	uint8_t navMode[NMEA_BATCH_LEN];
+	uint8_t fix_type[NMEA_BATCH_LEN];
+	float pdop[NMEA_BATCH_LEN];
+	float hdop[NMEA_BATCH_LEN];
+	float vdop[NMEA_BATCH_LEN];
+}NMEA_Columns_GSA_t;
+
+typedef struct NMEA_Columns_GST_s {
+	uint32_t count;
+	uint8_t talkerId[NMEA_BATCH_LEN];
+	int32_t time[NMEA_BATCH_LEN];
+	float rangeRms[NMEA_BATCH_LEN];
+	float stdMajor[NMEA_BATCH_LEN];
+	float stdMinor[NMEA_BATCH_LEN];
+	float orient[NMEA_BATCH_LEN];
+	float stdLat[NMEA_BATCH_LEN];
+	float stdLon[NMEA_BATCH_LEN];
+	float stdAlt[NMEA_BATCH_LEN];
+}NMEA_Columns_GST_t;
+
+typedef struct NMEA_Columns_RMC_s {
+	uint32_t count;
+	uint8_t talkerId[NMEA_BATCH_LEN];
+	int32_t time[NMEA_BATCH_LEN];
+	char status[NMEA_BATCH_LEN];
+	int32_t latitude[NMEA_BATCH_LEN];
+	int32_t longitude[NMEA_BATCH_LEN];
+	float speed[NMEA_BATCH_LEN];
+	float course[NMEA_BATCH_LEN];
+	int32_t date[NMEA_BATCH_LEN];
+	float variation[NMEA_BATCH_LEN];
+	char posMode[NMEA_BATCH_LEN];
+}NMEA_Columns_RMC_t;
+
+typedef struct NMEA_Columns_VLW_s {
+	uint32_t count;
+	uint8_t talkerId[NMEA_BATCH_LEN];
+	float twd[NMEA_BATCH_LEN];
+	float wd[NMEA_BATCH_LEN];
+	float tgd[NMEA_BATCH_LEN];
+	float gd[NMEA_BATCH_LEN];
+}NMEA_Columns_VLW_t;
+
+typedef struct NMEA_Columns_VTG_s {
+	uint32_t count;
+	uint8_t talkerId[NMEA_BATCH_LEN];
+	float cogt[NMEA_BATCH_LEN];
+	float cogm[NMEA_BATCH_LEN];
+	float sogn[NMEA_BATCH_LEN];
+	float sogk[NMEA_BATCH_LEN];
+	char posMode[NMEA_BATCH_LEN];
+}NMEA_Columns_VTG_t;
+
+typedef struct NMEA_Columns_ZDA_s {
+	uint32_t count;
+	uint8_t talkerId[NMEA_BATCH_LEN];
+	int32_t time[NMEA_BATCH_LEN];
+	int32_t date[NMEA_BATCH_LEN];
+	int32_t hour_offset[NMEA_BATCH_LEN];
+	int32_t minute_offset[NMEA_BATCH_LEN];
+}NMEA_Columns_ZDA_t;
+
+/*
+*  Batch context. Large, allocate it statically or on the heap.
+*/
+typedef struct NMEA_Batch_s {
+	NMEA_Parser_t parser;		// Packing statistics & flags (NMEA_PARSER_CHECKSUM)
+	uint32_t skipped;			// Packed sentences without column set or failed to parse
+
+	NMEA_Columns_GBS_t gbs;
+	NMEA_Columns_GGA_t gga;
+	NMEA_Columns_GLL_t gll;
+	NMEA_Columns_GNS_t gns;
+	NMEA_Columns_GSA_t gsa;
+	NMEA_Columns_GST_t gst;
+	NMEA_Columns_RMC_t rmc;
+	NMEA_Columns_VLW_t vlw;
+	NMEA_Columns_VTG_t vtg;
+	NMEA_Columns_ZDA_t zda;
+}NMEA_Batch_t;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+void NMEA_Batch_Init(NMEA_Batch_t* batch);
+
+/* Empties all column sets, keeps the parser statistics. */
+void NMEA_Batch_Clear(NMEA_Batch_t* batch);
+
+/**
+ * Parses every complete line of buf into the batch columns, a line ends at
+ * CR or LF and a '$' inside it starts the line over, as NMEA_Feed does. Stops before a sentence whose column set is full, or before a
+ * trailing line without CR or LF. Returns the consumed byte count: clear the batch after the
+ * columns are used, and call again with the rest of the buffer.
+ */
+size_t NMEA_ParseBatch(NMEA_Batch_t* batch, const uint8_t* buf, size_t len);
+
+#endif /* NMEA_BATCH_H_ */
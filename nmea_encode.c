@@ -0,0 +1,634 @@
+/*
+ *	nmea_encode.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  NMEA sentence encoder, the inverse of the NMEA_*_Parse functions.
+ *
+ *  16.10.2026 : File is created.
+ *  16.10.2026 : Empty numeric fields documented, they are written as 0.
+ *
+ *	References:
+ *	[1] u-blox8-M8_ReceiverDescrProtSpec_(UBX-13003221), sentence layouts.
+ *
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "nmea_encode.h"
+
+#define NMEA_ENCODE_MAX_DECIMALS	17		// "0." + 17 digits, NMEA_ParseDecimal keeps 15 significant ones
+
+static const char* const Enc_Talker[] = {
+	[NMEA_TALKER_GP] = "GP",
+	[NMEA_TALKER_GL] = "GL",
+	[NMEA_TALKER_GA] = "GA",
+	[NMEA_TALKER_GB] = "GB",
+	[NMEA_TALKER_GN] = "GN",
+	[NMEA_TALKER_GQ] = "GQ",
+	[NMEA_TALKER_BD] = "BD",
+	[NMEA_TALKER_GI] = "GI",
+};
+
+static const char* const Enc_Payload[] = {
+	[NMEA_MSG_DTM] = "DTM",
+	[NMEA_MSG_GBS] = "GBS",
+	[NMEA_MSG_GGA] = "GGA",
+	[NMEA_MSG_GLL] = "GLL",
+	[NMEA_MSG_GNS] = "GNS",
+	[NMEA_MSG_GRS] = "GRS",
+	[NMEA_MSG_GSA] = "GSA",
+	[NMEA_MSG_GST] = "GST",
+	[NMEA_MSG_GSV] = "GSV",
+	[NMEA_MSG_RMC] = "RMC",
+	[NMEA_MSG_TXT] = "TXT",
+	[NMEA_MSG_VLW] = "VLW",
+	[NMEA_MSG_VTG] = "VTG",
+	[NMEA_MSG_ZDA] = "ZDA",
+};
+
+static const double Enc_Pow10[NMEA_ENCODE_MAX_DECIMALS + 1] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+	1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+};
+
+static const char Enc_Hex[] = "0123456789ABCDEF";
+
+/*
+*  Sentence writer. Every byte between '$' and '*' is XORed into the checksum
+*  as it is written, a full buffer is reported once at the end.
+*/
+typedef struct Enc_Writer_s {
+	char* buf;
+	size_t size;
+	size_t len;
+	uint8_t checksum;
+	bool full;
+}Enc_Writer_t;
+
+static inline void Enc_Put(Enc_Writer_t* w, char c) {
+	if (w->len >= w->size) {
+		w->full = true;
+		return;
+	}
+	w->buf[w->len++] = c;
+	w->checksum ^= (uint8_t)c;
+}
+
+/* Decimal digits, zero padded to width. */
+static void Enc_Digits(Enc_Writer_t* w, uint64_t value, uint8_t width) {
+	char digits[20];
+	uint8_t n = 0;
+
+	do {
+		digits[n++] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value);
+	while (n < width && n < sizeof(digits)) digits[n++] = '0';
+
+	while (n) Enc_Put(w, digits[--n]);
+}
+
+static inline void Enc_Empty(Enc_Writer_t* w) {
+	Enc_Put(w, ',');
+}
+
+static void Enc_Token(Enc_Writer_t* w, const char* token) {
+	Enc_Put(w, ',');
+	while (*token) Enc_Put(w, *token++);
+}
+
+static void Enc_Uint(Enc_Writer_t* w, uint32_t value, uint8_t width) {
+	Enc_Put(w, ',');
+	Enc_Digits(w, value, width);
+}
+
+static void Enc_Int(Enc_Writer_t* w, int32_t value, uint8_t width) {
+	Enc_Put(w, ',');
+	if (value < 0) Enc_Put(w, '-');
+	Enc_Digits(w, (value < 0) ? (uint64_t)(-(int64_t)value) : (uint64_t)value, width);
+}
+
+/* Satellite IDs & SNR, 0 is written as an empty field. */
+static void Enc_Nonzero(Enc_Writer_t* w, int32_t value, uint8_t width) {
+	if (!value) Enc_Empty(w);
+	else Enc_Int(w, value, width);
+}
+
+/* The parsers decode an empty char field to ' '. */
+static void Enc_Char(Enc_Writer_t* w, char c) {
+	Enc_Put(w, ',');
+	if (c != ' ' && c != '\0') Enc_Put(w, c);
+}
+
+/* Framing characters can't be carried, they are dropped. */
+static void Enc_Text(Enc_Writer_t* w, const char* text, size_t size) {
+	Enc_Put(w, ',');
+	for (size_t i = 0; i < size && text[i]; i++) {
+		if (text[i] == '*' || text[i] == '$' || text[i] == '\r' || text[i] == '\n') continue;
+		Enc_Put(w, text[i]);
+	}
+}
+
+static void Enc_Direction(Enc_Writer_t* w, int8_t direction, char positive, char negative) {
+	Enc_Put(w, ',');
+	if (direction > 0) Enc_Put(w, positive);
+	else if (direction < 0) Enc_Put(w, negative);
+}
+
+/**
+* Shortest fixed-point decimal that NMEA_Field_Float reads back to the same
+* float: the first scale whose mantissa / 10^scale, divided in double and
+* narrowed like the parser does, matches. NaN, infinities and magnitudes past
+* 2^53 have no field form and are written empty. 0 is written as "0", the
+* parser gives 0 for an empty field too and the struct can't tell them apart.
+*/
+static void Enc_Float(Enc_Writer_t* w, float value) {
+	Enc_Put(w, ',');
+
+	float target = (value < 0) ? -value : value;
+	double magnitude = (double)target;
+	if (target != target || magnitude >= 9007199254740992.0) return;
+
+	uint64_t mantissa = 0;
+	uint8_t scale = 0;
+
+	for (uint8_t s = 0; s <= NMEA_ENCODE_MAX_DECIMALS; s++) {
+		double scaled = magnitude * Enc_Pow10[s];
+		if (scaled >= 9007199254740992.0) break;
+
+		mantissa = (uint64_t)(scaled + 0.5);
+		scale = s;
+		if ((float)((double)mantissa / Enc_Pow10[s]) == target) break;
+	}
+
+	if (value < 0 && mantissa) Enc_Put(w, '-');
+
+	if (!scale) {
+		Enc_Digits(w, mantissa, 1);
+		return;
+	}
+
+	uint64_t unit = 1;
+	for (uint8_t i = 0; i < scale; i++) unit *= 10;
+
+	Enc_Digits(w, mantissa / unit, 1);
+	Enc_Put(w, '.');
+	Enc_Digits(w, mantissa % unit, scale);
+}
+
+/**
+* 1e-7 degrees as (d)ddmm.mmmmmmm. 1e-7 degree is exactly 6e-6 minute, so 7
+* minute decimals carry any value; trailing zeros past the usual 5 are cut.
+*/
+static void Enc_Location(Enc_Writer_t* w, int32_t value, uint8_t degreeWidth) {
+	Enc_Put(w, ',');
+	if (value == -1) return;
+
+	if (value < 0) Enc_Put(w, '-');
+	uint32_t magnitude = (value < 0) ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+
+	uint64_t minutes = (uint64_t)(magnitude % 10000000) * 60;		// 1e-7 minute
+	uint64_t fraction = minutes % 10000000;
+	uint8_t decimals = 7;
+
+	while (decimals > 5 && fraction % 10 == 0) {
+		fraction /= 10;
+		decimals--;
+	}
+
+	Enc_Digits(w, magnitude / 10000000, degreeWidth);
+	Enc_Digits(w, minutes / 10000000, 2);
+	Enc_Put(w, '.');
+	Enc_Digits(w, fraction, decimals);
+}
+
+/* hhmmss.ss, or hhmmss.sss when the milliseconds need it. */
+static void Enc_Time(Enc_Writer_t* w, const NMEA_Time_t* time) {
+	Enc_Put(w, ',');
+	if (time->hour < 0) return;
+
+	int32_t fraction = (time->ms > 0) ? time->ms % 1000 : 0;
+
+	Enc_Digits(w, (uint64_t)time->hour, 2);
+	Enc_Digits(w, (uint64_t)time->min, 2);
+	Enc_Digits(w, (uint64_t)time->sec, 2);
+	Enc_Put(w, '.');
+	if (fraction % 10) Enc_Digits(w, (uint64_t)fraction, 3);
+	else Enc_Digits(w, (uint64_t)(fraction / 10), 2);
+}
+
+static void Enc_Date(Enc_Writer_t* w, const NMEA_Date_t* date) {
+	Enc_Put(w, ',');
+	if (date->year < 0) return;
+
+	Enc_Digits(w, (uint64_t)date->day, 2);
+	Enc_Digits(w, (uint64_t)date->month, 2);
+	Enc_Digits(w, (uint64_t)(date->year % 100), 2);
+}
+
+static bool Enc_Begin(Enc_Writer_t* w, char* buf, size_t size, uint8_t talkerId, uint8_t payloadId) {
+	if (talkerId >= sizeof(Enc_Talker) / sizeof(Enc_Talker[0]) || !Enc_Talker[talkerId]) return false;
+
+	w->buf = buf;
+	w->size = size;
+	w->len = 0;
+	w->full = false;
+
+	Enc_Put(w, '$');
+	w->checksum = 0;
+	Enc_Put(w, Enc_Talker[talkerId][0]);
+	Enc_Put(w, Enc_Talker[talkerId][1]);
+	Enc_Put(w, Enc_Payload[payloadId][0]);
+	Enc_Put(w, Enc_Payload[payloadId][1]);
+	Enc_Put(w, Enc_Payload[payloadId][2]);
+	return true;
+}
+
+/* "*hh\r\n" and the NUL. Returns 0 if anything didn't fit. */
+static size_t Enc_Finish(Enc_Writer_t* w) {
+	if (w->full || w->len + 6 > w->size) return 0;
+
+	uint8_t checksum = w->checksum;
+	w->buf[w->len++] = '*';
+	w->buf[w->len++] = Enc_Hex[checksum >> 4];
+	w->buf[w->len++] = Enc_Hex[checksum & 0x0F];
+	w->buf[w->len++] = '\r';
+	w->buf[w->len++] = '\n';
+	w->buf[w->len] = '\0';
+	return w->len;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/* DTM Datum reference.
+*/
+size_t NMEA_DTM_Encode(const NMEA_Payload_DTM_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_DTM)) return 0;
+
+	//$GPDTM,W84,,0.0,N,0.0,E,0.0,W84*6F
+
+	Enc_Text(&w, frame->datum, sizeof(frame->datum));
+	Enc_Text(&w, frame->subDatum, sizeof(frame->subDatum));
+	Enc_Float(&w, frame->latOffset);
+	Enc_Direction(&w, frame->ns_d, 'N', 'S');
+	Enc_Float(&w, frame->lonOffset);
+	Enc_Direction(&w, frame->ew_d, 'E', 'W');
+	Enc_Float(&w, frame->altOffset);
+	Enc_Text(&w, frame->refDatum, sizeof(frame->refDatum));
+	return Enc_Finish(&w);
+}
+
+/* GBS GNSS satellite fault detection.
+*/
+size_t NMEA_GBS_Encode(const NMEA_Payload_GBS_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_GBS)) return 0;
+
+	//$GPGBS,235458.00,1.4,1.3,3.1,03,0,-21.4,3.8*6B
+
+	Enc_Time(&w, &frame->time);
+	Enc_Float(&w, frame->errLat);
+	Enc_Float(&w, frame->errLon);
+	Enc_Float(&w, frame->errAlt);
+	Enc_Nonzero(&w, frame->svid, 2);
+	Enc_Float(&w, frame->prob);
+	Enc_Float(&w, frame->bias);
+	Enc_Float(&w, frame->stddev);
+	return Enc_Finish(&w);
+}
+
+/* GGA Global Positioning System Fix Data.
+*/
+size_t NMEA_GGA_Encode(const NMEA_Payload_GGA_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_GGA)) return 0;
+
+	//$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B
+
+	Enc_Time(&w, &frame->time);
+	Enc_Location(&w, frame->location.latitude, 2);
+	Enc_Direction(&w, frame->location.ns_d, 'N', 'S');
+	Enc_Location(&w, frame->location.longitude, 3);
+	Enc_Direction(&w, frame->location.ew_d, 'E', 'W');
+	Enc_Uint(&w, frame->quality, 1);
+	Enc_Uint(&w, frame->satellite_n, 2);
+	Enc_Float(&w, frame->hdop);
+	Enc_Float(&w, frame->altitude);
+	Enc_Token(&w, "M");
+	Enc_Float(&w, frame->separation);
+	Enc_Token(&w, "M");
+	if (frame->diffAge == 0 && frame->diffStation == 0) {
+		Enc_Empty(&w);
+		Enc_Empty(&w);
+	}
+	else {
+		Enc_Float(&w, frame->diffAge);
+		Enc_Int(&w, frame->diffStation, 4);
+	}
+	return Enc_Finish(&w);
+}
+
+/* GLL Latitude and longitude, with time of position fix and status.
+*/
+size_t NMEA_GLL_Encode(const NMEA_Payload_GLL_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_GLL)) return 0;
+
+	//$GPGLL,4717.11364,N,00833.91565,E,092321.00,A,A*60
+
+	Enc_Location(&w, frame->location.latitude, 2);
+	Enc_Direction(&w, frame->location.ns_d, 'N', 'S');
+	Enc_Location(&w, frame->location.longitude, 3);
+	Enc_Direction(&w, frame->location.ew_d, 'E', 'W');
+	Enc_Time(&w, &frame->time);
+	Enc_Char(&w, frame->status);
+	Enc_Char(&w, frame->posMode);
+	return Enc_Finish(&w);
+}
+
+/* GNS GNSS fix data.
+*/
+size_t NMEA_GNS_Encode(const NMEA_Payload_GNS_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_GNS)) return 0;
+
+	//$GNGNS,103600.01,5114.51176,N,00012.29380,W,ANNN,07,1.18,111.5,45.6,,,V*00
+
+	Enc_Time(&w, &frame->time);
+	Enc_Location(&w, frame->location.latitude, 2);
+	Enc_Direction(&w, frame->location.ns_d, 'N', 'S');
+	Enc_Location(&w, frame->location.longitude, 3);
+	Enc_Direction(&w, frame->location.ew_d, 'E', 'W');
+	Enc_Text(&w, frame->posMode, sizeof(frame->posMode));
+	Enc_Uint(&w, frame->numSV, 2);
+	Enc_Float(&w, frame->hdop);
+	Enc_Float(&w, frame->altitude);
+	Enc_Float(&w, frame->separation);
+	if (frame->diffAge == 0 && frame->diffStation == 0) {
+		Enc_Empty(&w);
+		Enc_Empty(&w);
+	}
+	else {
+		Enc_Float(&w, frame->diffAge);
+		Enc_Int(&w, frame->diffStation, 4);
+	}
+	Enc_Char(&w, frame->navStatus);
+	return Enc_Finish(&w);
+}
+
+/* GRS GNSS range residuals. Slots past residual_n are left empty.
+*/
+size_t NMEA_GRS_Encode(const NMEA_Payload_GRS_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_GRS)) return 0;
+
+	//$GNGRS,104148.00,1,2.6,2.2,-1.6,-1.1,-1.7,-1.5,5.8,1.7,,,,,1,1*52
+
+	Enc_Time(&w, &frame->time);
+	Enc_Uint(&w, frame->mode, 1);
+	for (uint8_t i = 0; i < NMEA_GRS_RESIDUALS; i++) {
+		if (i < frame->residual_n) Enc_Float(&w, frame->residual[i]);
+		else Enc_Empty(&w);
+	}
+	Enc_Uint(&w, frame->systemId, 1);
+	Enc_Uint(&w, frame->signalId, 1);
+	return Enc_Finish(&w);
+}
+
+/* GSA GNSS DOP and active satellites.
+*/
+size_t NMEA_GSA_Encode(const NMEA_Payload_GSA_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_GSA)) return 0;
+
+	//$GPGSA,A,3,23,29,07,08,09,18,26,28,,,,,1.94,1.18,1.54,1*0D
+
+	Enc_Char(&w, frame->opMode);
+	Enc_Uint(&w, frame->navMode, 1);
+	for (uint8_t i = 0; i < 12; i++) {
+		Enc_Nonzero(&w, frame->sats[i], 2);
+	}
+	Enc_Float(&w, frame->pdop);
+	Enc_Float(&w, frame->hdop);
+	Enc_Float(&w, frame->vdop);
+	Enc_Uint(&w, frame->fix_type, 1);
+	return Enc_Finish(&w);
+}
+
+/* GST GNSS pseudorange error statistics.
+*/
+size_t NMEA_GST_Encode(const NMEA_Payload_GST_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_GST)) return 0;
+
+	//$GPGST,082356.00,1.8,,,,1.7,1.3,2.2*7E
+
+	Enc_Time(&w, &frame->time);
+	Enc_Float(&w, frame->rangeRms);
+	Enc_Float(&w, frame->stdMajor);
+	Enc_Float(&w, frame->stdMinor);
+	Enc_Float(&w, frame->orient);
+	Enc_Float(&w, frame->stdLat);
+	Enc_Float(&w, frame->stdLon);
+	Enc_Float(&w, frame->stdAlt);
+	return Enc_Finish(&w);
+}
+
+/* GSV GNSS satellites in view. Writes the satellite blocks numSV leaves for
+*  this part, at most 4.
+*/
+size_t NMEA_GSV_Encode(const NMEA_Payload_GSV_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_GSV)) return 0;
+
+	//$GPGSV,1,1,03,12,00,000,42,24,00,000,47,32,00,000,37,5*56
+
+	int32_t blocks = frame->numSV - (frame->msgNum ? frame->msgNum - 1 : 0) * 4;
+	if (blocks < 0) blocks = 0;
+	if (blocks > 4) blocks = 4;
+
+	Enc_Uint(&w, frame->numMsg, 1);
+	Enc_Uint(&w, frame->msgNum, 1);
+	Enc_Int(&w, frame->numSV, 2);
+	for (int32_t i = 0; i < blocks; i++) {
+		Enc_Int(&w, frame->sats[i].nr, 2);
+		Enc_Int(&w, frame->sats[i].elevation, 2);
+		Enc_Int(&w, frame->sats[i].azimuth, 3);
+		Enc_Nonzero(&w, frame->sats[i].snr, 2);
+	}
+	if (frame->signalId) Enc_Uint(&w, frame->signalId, 1);
+	return Enc_Finish(&w);
+}
+
+/* RMC Recommended minimum data. The variation direction isn't kept by the
+*  parser and is written empty.
+*/
+size_t NMEA_RMC_Encode(const NMEA_Payload_RMC_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_RMC)) return 0;
+
+	//$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*57
+
+	Enc_Time(&w, &frame->time);
+	Enc_Char(&w, frame->status);
+	Enc_Location(&w, frame->location.latitude, 2);
+	Enc_Direction(&w, frame->location.ns_d, 'N', 'S');
+	Enc_Location(&w, frame->location.longitude, 3);
+	Enc_Direction(&w, frame->location.ew_d, 'E', 'W');
+	Enc_Float(&w, frame->speed);
+	Enc_Float(&w, frame->course);
+	Enc_Date(&w, &frame->date);
+	Enc_Float(&w, frame->variation);
+	Enc_Empty(&w);
+	Enc_Char(&w, frame->posMode);
+	Enc_Char(&w, frame->navStatus);
+	return Enc_Finish(&w);
+}
+
+/* TXT Text transmission.
+*/
+size_t NMEA_TXT_Encode(const NMEA_Payload_TXT_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_TXT)) return 0;
+
+	//$GPTXT,01,01,02,u-blox ag - www.u-blox.com*50
+
+	Enc_Uint(&w, frame->numMsg, 2);
+	Enc_Uint(&w, frame->msgNum, 2);
+	Enc_Uint(&w, frame->msgType, 2);
+	Enc_Text(&w, frame->text, sizeof(frame->text));
+	return Enc_Finish(&w);
+}
+
+/* VLW Dual ground/water distance.
+*/
+size_t NMEA_VLW_Encode(const NMEA_Payload_VLW_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_VLW)) return 0;
+
+	//$GPVLW,,N,,N,15.8,N,1.2,N*65
+
+	Enc_Float(&w, frame->twd);
+	Enc_Token(&w, "N");
+	Enc_Float(&w, frame->wd);
+	Enc_Token(&w, "N");
+	Enc_Float(&w, frame->tgd);
+	Enc_Token(&w, "N");
+	Enc_Float(&w, frame->gd);
+	Enc_Token(&w, "N");
+	return Enc_Finish(&w);
+}
+
+/* VTG Course over ground and ground speed.
+*/
+size_t NMEA_VTG_Encode(const NMEA_Payload_VTG_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_VTG)) return 0;
+
+	//$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06
+
+	Enc_Float(&w, frame->cogt);
+	Enc_Token(&w, "T");
+	Enc_Float(&w, frame->cogm);
+	Enc_Token(&w, "M");
+	Enc_Float(&w, frame->sogn);
+	Enc_Token(&w, "N");
+	Enc_Float(&w, frame->sogk);
+	Enc_Token(&w, "K");
+	Enc_Char(&w, frame->posMode);
+	return Enc_Finish(&w);
+}
+
+/* ZDA Time and Date.
+*/
+size_t NMEA_ZDA_Encode(const NMEA_Payload_ZDA_t* frame, uint8_t talkerId, char* buf, size_t size) {
+	Enc_Writer_t w;
+	if (!Enc_Begin(&w, buf, size, talkerId, NMEA_MSG_ZDA)) return 0;
+
+	//$GPZDA,082710.00,16,09,2002,00,00*64
+
+	Enc_Time(&w, &frame->time);
+	Enc_Int(&w, frame->date.day, 2);
+	Enc_Int(&w, frame->date.month, 2);
+	Enc_Int(&w, frame->date.year, 4);
+	Enc_Int(&w, frame->hour_offset, 2);
+	Enc_Int(&w, frame->minute_offset, 2);
+	return Enc_Finish(&w);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+*  Encoder jump table, same layout as the parser table of nmea.c.
+*/
+#define NMEA_ENCODE_THUNK(type, member) \
+	static size_t NMEA_Encode_##type(const NMEA_Payload_t* frame, uint8_t talkerId, char* buf, size_t size) { \
+		return NMEA_##type##_Encode(&frame->member, talkerId, buf, size); \
+	}
+
+NMEA_ENCODE_THUNK(DTM, dtm)
+NMEA_ENCODE_THUNK(GBS, gbs)
+NMEA_ENCODE_THUNK(GGA, gga)
+NMEA_ENCODE_THUNK(GLL, gll)
+NMEA_ENCODE_THUNK(GNS, gns)
+NMEA_ENCODE_THUNK(GRS, grs)
+NMEA_ENCODE_THUNK(GSA, gsa)
+NMEA_ENCODE_THUNK(GST, gst)
+NMEA_ENCODE_THUNK(GSV, gsv)
+NMEA_ENCODE_THUNK(RMC, rmc)
+NMEA_ENCODE_THUNK(TXT, txt)
+NMEA_ENCODE_THUNK(VLW, vlw)
+NMEA_ENCODE_THUNK(VTG, vtg)
+NMEA_ENCODE_THUNK(ZDA, zda)
+
+typedef size_t (*NMEA_EncodeFunc_t)(const NMEA_Payload_t* frame, uint8_t talkerId, char* buf, size_t size);
+
+static const NMEA_EncodeFunc_t Encode_Table[NMEA_MSG_ZDA + 1] = {
+	[NMEA_MSG_DTM] = NMEA_Encode_DTM,
+	[NMEA_MSG_GBS] = NMEA_Encode_GBS,
+	[NMEA_MSG_GGA] = NMEA_Encode_GGA,
+	[NMEA_MSG_GLL] = NMEA_Encode_GLL,
+	[NMEA_MSG_GNS] = NMEA_Encode_GNS,
+	[NMEA_MSG_GRS] = NMEA_Encode_GRS,
+	[NMEA_MSG_GSA] = NMEA_Encode_GSA,
+	[NMEA_MSG_GST] = NMEA_Encode_GST,
+	[NMEA_MSG_GSV] = NMEA_Encode_GSV,
+	[NMEA_MSG_RMC] = NMEA_Encode_RMC,
+	[NMEA_MSG_TXT] = NMEA_Encode_TXT,
+	[NMEA_MSG_VLW] = NMEA_Encode_VLW,
+	[NMEA_MSG_VTG] = NMEA_Encode_VTG,
+	[NMEA_MSG_ZDA] = NMEA_Encode_ZDA,
+};
+
+static bool NMEA_Encode_Supported(uint8_t talkerId, uint8_t payloadId) {
+	if (payloadId > NMEA_MSG_ZDA || !Encode_Table[payloadId]) return false;
+	return talkerId < sizeof(Enc_Talker) / sizeof(Enc_Talker[0]) && Enc_Talker[talkerId];
+}
+
+size_t NMEA_Encode(const NMEA_Payload_t* frame, uint8_t talkerId, uint8_t payloadId, char* buf, size_t size) {
+	if (!NMEA_Encode_Supported(talkerId, payloadId)) return 0;
+	return Encode_Table[payloadId](frame, talkerId, buf, size);
+}
+
+size_t NMEA_EncodeBatch(const NMEA_Record_t* records, size_t count, char* buf, size_t size, size_t* consumed) {
+	size_t len = 0;
+	size_t i = 0;
+
+	for (; i < count; i++) {
+		const NMEA_Record_t* record = &records[i];
+		if (!NMEA_Encode_Supported(record->talkerId, record->payloadId)) continue;
+
+		/* Each sentence overwrites the NUL of the previous one. */
+		size_t n = Encode_Table[record->payloadId](&record->payload, record->talkerId, &buf[len], size - len);
+		if (!n) break;
+		len += n;
+	}
+
+	*consumed = i;
+	return len;
+}
@@ -0,0 +1,73 @@
+/*
+ *	nmea_encode.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  NMEA sentence encoder, the inverse of the NMEA_*_Parse functions. Writes
+ *  payload structs as "$<talker><payload>,...*hh\r\n" into caller buffers.
+ *  No printf, no allocation, the checksum is accumulated while writing.
+ *
+ *  Every member a parser decodes survives NMEA_Pack + parse bit-exactly:
+ *  floats are written with the fewest decimals that read back to the same
+ *  float, locations with up to 7 minute decimals (exact for the 1e-7 degree
+ *  scale), times with 2 or 3 second decimals.
+ *
+ *  The structs don't tell an empty numeric field from a zero one, the parsers
+ *  decode both to 0, so those are written as values: VTG ",,M" comes back as
+ *  ",0,M", empty GST errors as ",0,0,0", an empty RMC variation as ",0", GSV
+ *  elevation / azimuth as "00,000" and empty ZDA date fields as ",00,00,0000".
+ *  Times, dates, locations, directions and chars with their empty value, SNR
+ *  and satellite IDs of 0 stay empty. The text differs, the parsed struct is
+ *  the same.
+ *
+ *  16.10.2026 : File is created.
+ *  16.10.2026 : Empty numeric fields documented, they are written as 0.
+ *
+ */
+
+#ifndef NMEA_ENCODE_H_
+#define NMEA_ENCODE_H_
+
+#include "nmea.h"
+#include "nmea_log.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Writes one sentence of the frame into buf, NUL terminated. Numeric members
+ * are always written, 0 included (see above).
+ * @param talkerId = NMEA_talkerId_e, proprietary '$P' sentences are not encoded.
+ * Returns the sentence length with CR LF, 0 if buf is too small.
+ */
+size_t NMEA_DTM_Encode(const NMEA_Payload_DTM_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_GBS_Encode(const NMEA_Payload_GBS_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_GGA_Encode(const NMEA_Payload_GGA_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_GLL_Encode(const NMEA_Payload_GLL_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_GNS_Encode(const NMEA_Payload_GNS_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_GRS_Encode(const NMEA_Payload_GRS_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_GSA_Encode(const NMEA_Payload_GSA_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_GST_Encode(const NMEA_Payload_GST_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_GSV_Encode(const NMEA_Payload_GSV_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_RMC_Encode(const NMEA_Payload_RMC_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_TXT_Encode(const NMEA_Payload_TXT_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_VLW_Encode(const NMEA_Payload_VLW_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_VTG_Encode(const NMEA_Payload_VTG_t* frame, uint8_t talkerId, char* buf, size_t size);
+size_t NMEA_ZDA_Encode(const NMEA_Payload_ZDA_t* frame, uint8_t talkerId, char* buf, size_t size);
+
+/**
+ * Encodes the union frame with the function of payloadId, jump table like
+ * NMEA_Parse. Returns 0 if the payload type has no encoder or buf is too small.
+ */
+size_t NMEA_Encode(const NMEA_Payload_t* frame, uint8_t talkerId, uint8_t payloadId, char* buf, size_t size);
+
+/**
+ * Encodes records back to back into buf. Stops before the first record that
+ * doesn't fit, records without an encoder are skipped.
+ * @param consumed = Receives the number of records written or skipped, call
+ * again from there after buf is sent.
+ * Returns the written byte count.
+ */
+size_t NMEA_EncodeBatch(const NMEA_Record_t* records, size_t count, char* buf, size_t size, size_t* consumed);
+
+#endif /* NMEA_ENCODE_H_ */
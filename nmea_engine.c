@@ -0,0 +1,133 @@
+/*
+ *	nmea_engine.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Multi-receiver engine for Linux hosts. Owns a pool of per-source framing
+ *  contexts, reads every source from one epoll loop and dispatches parsed
+ *  sentences to per-type handlers.
+ *
+ *  16.10.2026 : File is created.
+ *
+ *  16.10.2026 : Handlers are a NMEA_Handlers_t table run by NMEA_Dispatch_Message,
+ *  the source of a sentence is NMEA_Engine_Current. NMEA_Engine_Feed checks the source id.
+ *
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#include "nmea_engine.h"
+
+static void NMEA_Engine_Dispatch(const NMEA_Message_t* msg, void* user) {
+	NMEA_Source_t* source = (NMEA_Source_t*)user;
+	NMEA_Engine_t* engine = source->engine;
+
+	/* Unregistered types are dropped before any field is converted. */
+	engine->current = (int32_t)(source - engine->pool);
+	if (!NMEA_Dispatch_Message(&engine->handlers, msg)) engine->unhandled++;
+	engine->current = -1;
+}
+
+static bool NMEA_Engine_InUse(const NMEA_Engine_t* engine, uint32_t source) {
+	if (source >= NMEA_ENGINE_MAX_SOURCES) return false;
+	return engine->pool[source].next == -1 && engine->pool[source].engine == engine;
+}
+
+bool NMEA_Engine_Init(NMEA_Engine_t* engine) {
+	memset(engine, 0, sizeof(NMEA_Engine_t));
+
+	NMEA_Handlers_Init(&engine->handlers);
+	engine->current = -1;
+
+	engine->epfd = epoll_create1(EPOLL_CLOEXEC);
+	if (engine->epfd < 0) return false;
+
+	for (int32_t i = 0; i < NMEA_ENGINE_MAX_SOURCES; i++) {
+		engine->pool[i].fd = -1;
+		engine->pool[i].next = (i + 1 < NMEA_ENGINE_MAX_SOURCES) ? i + 1 : -1;
+	}
+	engine->free = 0;
+	return true;
+}
+
+void NMEA_Engine_Close(NMEA_Engine_t* engine) {
+	if (engine->epfd >= 0) close(engine->epfd);
+	engine->epfd = -1;
+}
+
+int32_t NMEA_Engine_Add(NMEA_Engine_t* engine, int fd, void* tag) {
+	int32_t id = engine->free;
+	if (id < 0) return -1;
+
+	NMEA_Source_t* source = &engine->pool[id];
+
+	if (fd >= 0) {
+		struct epoll_event event = { .events = EPOLLIN, .data.u32 = (uint32_t)id };
+		if (epoll_ctl(engine->epfd, EPOLL_CTL_ADD, fd, &event) != 0) return -1;
+	}
+
+	engine->free = source->next;
+	engine->sources++;
+
+	NMEA_Parser_Init(&source->parser);
+	NMEA_Parser_SetCallback(&source->parser, NMEA_Engine_Dispatch, source);
+	source->engine = engine;
+	source->tag = tag;
+	source->fd = fd;
+	source->next = -1;
+	return id;
+}
+
+void NMEA_Engine_Remove(NMEA_Engine_t* engine, uint32_t source) {
+	if (!NMEA_Engine_InUse(engine, source)) return;
+
+	NMEA_Source_t* entry = &engine->pool[source];
+
+	if (entry->fd >= 0) epoll_ctl(engine->epfd, EPOLL_CTL_DEL, entry->fd, NULL);
+
+	entry->engine = NULL;
+	entry->fd = -1;
+	entry->next = engine->free;
+	engine->free = (int32_t)source;
+	engine->sources--;
+}
+
+uint32_t NMEA_Engine_Feed(NMEA_Engine_t* engine, uint32_t source, const uint8_t* buf, size_t len) {
+	if (!NMEA_Engine_InUse(engine, source)) return 0;
+	return NMEA_Feed(&engine->pool[source].parser, buf, len);
+}
+
+int NMEA_Engine_Poll(NMEA_Engine_t* engine, int timeout) {
+	struct epoll_event events[NMEA_ENGINE_EVENTS];
+	uint8_t buf[NMEA_ENGINE_READ_LEN];
+
+	int ready = epoll_wait(engine->epfd, events, NMEA_ENGINE_EVENTS, timeout);
+	if (ready < 0) return (errno == EINTR) ? 0 : -1;
+
+	for (int i = 0; i < ready; i++) {
+		uint32_t id = events[i].data.u32;
+		NMEA_Source_t* source = &engine->pool[id];
+		if (source->engine != engine) continue;	// Removed by a handler of this poll
+
+		ssize_t n = read(source->fd, buf, sizeof(buf));
+
+		if (n > 0) {
+			NMEA_Feed(&source->parser, buf, (size_t)n);
+			continue;
+		}
+		if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue;
+
+		/* EOF or read error. */
+		int fd = source->fd;
+		if (engine->closed) engine->closed(id, fd, engine->closedUser);
+		NMEA_Engine_Remove(engine, id);
+	}
+
+	return ready;
+}
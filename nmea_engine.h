@@ -0,0 +1,105 @@
+/*
+ *	nmea_engine.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Multi-receiver engine for Linux hosts. Owns a pool of per-source framing
+ *  contexts, reads every source from one epoll loop and dispatches parsed
+ *  sentences to per-type handlers.
+ *
+ *  16.10.2026 : File is created.
+ *
+ *  16.10.2026 : Handlers are a NMEA_Handlers_t table run by NMEA_Dispatch_Message,
+ *  the source of a sentence is NMEA_Engine_Current. NMEA_Engine_Feed checks the source id.
+ *
+ */
+
+#ifndef NMEA_ENGINE_H_
+#define NMEA_ENGINE_H_
+
+#include "nmea.h"
+
+#ifndef NMEA_ENGINE_MAX_SOURCES
+#define NMEA_ENGINE_MAX_SOURCES		256		// Pool size, fixed at compile time.
+#endif
+
+#define NMEA_ENGINE_READ_LEN		4096	// Bytes read per ready source and poll.
+#define NMEA_ENGINE_EVENTS			64		// epoll events per NMEA_Engine_Poll.
+#ifndef NMEA_CACHE_LINE
+#define NMEA_CACHE_LINE				64
+#endif
+
+/* Source hit EOF or a read error and was removed. The fd is not closed. */
+typedef void (*NMEA_Closed_t)(uint32_t source, int fd, void* user);
+
+struct NMEA_Engine_s;
+
+/*
+*  Pool entry, one per receiver. Cache line aligned so sources fed from
+*  different threads never share a line.
+*/
+typedef struct NMEA_Source_s {
+	NMEA_Parser_t parser;			// Framer state & statistics of this source
+	struct NMEA_Engine_s* engine;
+	void* tag;						// Caller data of the source
+	int fd;							// -1 for NMEA_Engine_Feed only sources
+	int32_t next;					// Free list link, -1 while in use
+} __attribute__((aligned(NMEA_CACHE_LINE))) NMEA_Source_t;
+
+/*
+*  Engine context. Large, allocate it statically or on the heap.
+*/
+typedef struct NMEA_Engine_s {
+	int epfd;
+	int32_t free;					// First free pool entry, -1 if full
+	uint32_t sources;				// Entries in use
+	uint32_t unhandled;				// Sentences without a handler or failed to parse
+	int32_t current;				// Source of the sentence being dispatched, -1 outside handlers
+
+	NMEA_Closed_t closed;			// Optional, called before a source is released
+	void* closedUser;
+
+	NMEA_Handlers_t handlers;		// NMEA_Handlers_Set(&engine->handlers, ...), shared by every source
+
+	NMEA_Source_t pool[NMEA_ENGINE_MAX_SOURCES];
+}NMEA_Engine_t;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+/* Returns 0 if the epoll instance can't be created. */
+bool NMEA_Engine_Init(NMEA_Engine_t* engine);
+void NMEA_Engine_Close(NMEA_Engine_t* engine);
+
+/**
+ * Takes a pool entry for a receiver. fd is registered with the epoll loop
+ * and should be non-blocking; pass -1 for sources fed by NMEA_Engine_Feed.
+ * Returns the source id, -1 if the pool is full or fd can't be registered.
+ */
+int32_t NMEA_Engine_Add(NMEA_Engine_t* engine, int fd, void* tag);
+
+/* Releases the pool entry, the fd is not closed. */
+void NMEA_Engine_Remove(NMEA_Engine_t* engine, uint32_t source);
+
+/**
+ * Frames bytes of one source received elsewhere (UDP demux, replay, ...).
+ * Returns the framed sentence count, 0 if source isn't in use.
+ */
+uint32_t NMEA_Engine_Feed(NMEA_Engine_t* engine, uint32_t source, const uint8_t* buf, size_t len);
+
+/**
+ * Waits up to timeout ms (-1 forever) and reads every ready source once.
+ * Returns the ready source count, -1 on epoll error.
+ */
+int NMEA_Engine_Poll(NMEA_Engine_t* engine, int timeout);
+
+/* Source id of the sentence, called from a handler. */
+static inline int32_t NMEA_Engine_Current(const NMEA_Engine_t* engine) {
+	return engine->current;
+}
+
+static inline NMEA_Source_t* NMEA_Engine_Source(NMEA_Engine_t* engine, uint32_t source) {
+	return &engine->pool[source];
+}
+
+#endif /* NMEA_ENGINE_H_ */
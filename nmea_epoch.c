@@ -0,0 +1,193 @@
+/*
+ *	nmea_epoch.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Epoch assembler. Merges the GGA, RMC, GSA, GST, VTG, GBS and ZDA sentences
+ *  of one navigation epoch into a single NMEA_Fix_t, keyed by their UTC time.
+ *
+ *  16.10.2026 : File is created.
+ *
+ *  16.10.2026 : GGA altitude, geoid separation & differential members.
+ *
+ *  16.10.2026 : Untimed parts never open a fix after an early emit, fixes always have a key.
+ *
+ *  16.10.2026 : A complete fix is held over a GSA run, every constellation is merged.
+ *
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "nmea_epoch.h"
+
+static int32_t NMEA_Epoch_Key(const NMEA_Time_t* time) {
+	return time->ms;
+}
+
+static void NMEA_Epoch_Open(NMEA_Epoch_t* epoch, uint8_t talkerId) {
+	memset(&epoch->fix, 0, sizeof(NMEA_Fix_t));
+	epoch->fix.key = -1;
+	epoch->fix.talkerId = talkerId;
+	epoch->open = true;
+}
+
+static void NMEA_Epoch_Emit(NMEA_Epoch_t* epoch) {
+	NMEA_Fix_t* fix = &epoch->fix;
+
+	epoch->open = false;
+	epoch->lastKey = fix->key;
+	epoch->emitted++;
+	if ((fix->parts & epoch->required) != epoch->required) epoch->incomplete++;
+
+	if (epoch->callback) epoch->callback(fix, epoch->user);
+}
+
+/* Required parts merged into a keyed open epoch. */
+static bool NMEA_Epoch_Complete(const NMEA_Epoch_t* epoch) {
+	return epoch->open && epoch->required && epoch->fix.key >= 0 && (epoch->fix.parts & epoch->required) == epoch->required;
+}
+
+static void NMEA_Epoch_Merge(NMEA_Fix_t* fix, uint8_t part, const NMEA_Payload_t* frame) {
+
+	switch (part) {
+	case(NMEA_FIX_GGA): {
+		if (!(fix->parts & NMEA_FIX_RMC)) fix->location = frame->gga.location;
+		fix->quality = frame->gga.quality;
+		fix->satellite_n = frame->gga.satellite_n;
+		fix->altitude = frame->gga.altitude;
+		fix->separation = frame->gga.separation;
+		fix->diffAge = frame->gga.diffAge;
+		fix->diffStation = frame->gga.diffStation;
+		if (!(fix->parts & NMEA_FIX_GSA)) fix->hdop = frame->gga.hdop;
+	}break;
+	case(NMEA_FIX_RMC): {
+		if (!(fix->parts & NMEA_FIX_GGA)) fix->location = frame->rmc.location;
+		if (frame->rmc.date.year >= 0) fix->date = frame->rmc.date;
+		fix->status = frame->rmc.status;
+		fix->posMode = frame->rmc.posMode;
+		fix->speed = frame->rmc.speed;
+		fix->course = frame->rmc.course;
+		fix->variation = frame->rmc.variation;
+	}break;
+	case(NMEA_FIX_GSA): {
+		/* One GSA per constellation, DOPs are the same for all of them. */
+		fix->opMode = frame->gsa.opMode;
+		fix->navMode = frame->gsa.navMode;
+		fix->pdop = frame->gsa.pdop;
+		fix->hdop = frame->gsa.hdop;
+		fix->vdop = frame->gsa.vdop;
+		for (uint8_t i = 0; i < 12 && fix->sats_n < NMEA_EPOCH_MAX_SATS; i++) {
+			if (frame->gsa.sats[i]) fix->sats[fix->sats_n++] = frame->gsa.sats[i];
+		}
+	}break;
+	case(NMEA_FIX_GST): {
+		fix->rangeRms = frame->gst.rangeRms;
+		fix->stdMajor = frame->gst.stdMajor;
+		fix->stdMinor = frame->gst.stdMinor;
+		fix->orient = frame->gst.orient;
+		fix->stdLat = frame->gst.stdLat;
+		fix->stdLon = frame->gst.stdLon;
+		fix->stdAlt = frame->gst.stdAlt;
+	}break;
+	case(NMEA_FIX_VTG): {
+		if (!(fix->parts & NMEA_FIX_RMC)) {
+			fix->course = frame->vtg.cogt;
+			fix->speed = frame->vtg.sogn;
+		}
+		fix->cogm = frame->vtg.cogm;
+		fix->sogk = frame->vtg.sogk;
+	}break;
+	case(NMEA_FIX_GBS): {
+		fix->errLat = frame->gbs.errLat;
+		fix->errLon = frame->gbs.errLon;
+		fix->errAlt = frame->gbs.errAlt;
+	}break;
+	case(NMEA_FIX_ZDA): {
+		if (!(fix->parts & NMEA_FIX_RMC) && frame->zda.date.year >= 0) fix->date = frame->zda.date;
+		fix->hour_offset = frame->zda.hour_offset;
+		fix->minute_offset = frame->zda.minute_offset;
+	}break;
+	}
+
+	fix->parts |= part;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+void NMEA_Epoch_Init(NMEA_Epoch_t* epoch, uint8_t required, NMEA_FixCallback_t callback, void* user) {
+	memset(epoch, 0, sizeof(NMEA_Epoch_t));
+	epoch->required = required;
+	epoch->callback = callback;
+	epoch->user = user;
+	epoch->lastKey = -1;
+}
+
+uint8_t NMEA_Epoch_Add(NMEA_Epoch_t* epoch, const NMEA_Message_t* msg) {
+	NMEA_Payload_t frame;
+	const NMEA_Time_t* time;
+	uint8_t part;
+
+	/* Only fix parts are converted, GSV / GLL / ... are skipped unparsed. */
+	switch (msg->payloadId) {
+	case(NMEA_MSG_GGA): part = NMEA_FIX_GGA; time = &frame.gga.time; break;
+	case(NMEA_MSG_RMC): part = NMEA_FIX_RMC; time = &frame.rmc.time; break;
+	case(NMEA_MSG_GSA): part = NMEA_FIX_GSA; time = NULL; break;
+	case(NMEA_MSG_GST): part = NMEA_FIX_GST; time = &frame.gst.time; break;
+	case(NMEA_MSG_VTG): part = NMEA_FIX_VTG; time = NULL; break;
+	case(NMEA_MSG_GBS): part = NMEA_FIX_GBS; time = &frame.gbs.time; break;
+	case(NMEA_MSG_ZDA): part = NMEA_FIX_ZDA; time = &frame.zda.time; break;
+	default: {
+		/* Any other sentence ends a GSA run, a held fix goes out. */
+		if (NMEA_Epoch_Complete(epoch)) NMEA_Epoch_Emit(epoch);
+		return 0;
+	}
+	}
+
+	if (!NMEA_Parse(&frame, msg)) return 0;
+
+	if (time && time->ms >= 0) {
+		int32_t key = NMEA_Epoch_Key(time);
+
+		/* A different time tag closes the open epoch. */
+		if (epoch->open && epoch->fix.key >= 0 && key != epoch->fix.key) NMEA_Epoch_Emit(epoch);
+
+		if ((!epoch->open || epoch->fix.key < 0) && key == epoch->lastKey) {
+			epoch->late++;
+			return 0;
+		}
+
+		if (!epoch->open) NMEA_Epoch_Open(epoch, msg->talkerId);
+		if (epoch->fix.key < 0) {
+			epoch->fix.key = key;
+			epoch->fix.time = *time;
+		}
+	}
+	else if (!epoch->open) {
+		/* Untimed parts after an early emit belong to the emitted epoch. */
+		if (epoch->lastKey >= 0) {
+			epoch->late++;
+			return 0;
+		}
+		NMEA_Epoch_Open(epoch, msg->talkerId);		// Stream start, keyed by the next timed part.
+	}
+
+	NMEA_Epoch_Merge(&epoch->fix, part, &frame);
+
+	/* One GSA per constellation follow each other, a fix they complete is held until the run ends. */
+	if (part != NMEA_FIX_GSA && NMEA_Epoch_Complete(epoch)) NMEA_Epoch_Emit(epoch);
+
+	return 1;
+}
+
+void NMEA_Epoch_Flush(NMEA_Epoch_t* epoch) {
+	/* Parts without any time tag don't make a fix. */
+	if (epoch->open && epoch->fix.key >= 0) NMEA_Epoch_Emit(epoch);
+	epoch->open = false;
+}
+
+void NMEA_Epoch_Callback(const NMEA_Message_t* msg, void* epoch) {
+	NMEA_Epoch_Add((NMEA_Epoch_t*)epoch, msg);
+}
@@ -0,0 +1,145 @@
+/*
+ *	nmea_epoch.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Epoch assembler. Merges the GGA, RMC, GSA, GST, VTG, GBS and ZDA sentences
+ *  of one navigation epoch into a single NMEA_Fix_t, keyed by their UTC time.
+ *
+ *  16.10.2026 : File is created.
+ *
+ *  16.10.2026 : GGA altitude, geoid separation & differential members.
+ *
+ *  16.10.2026 : Untimed parts never open a fix after an early emit, fixes always have a key.
+ *
+ *  16.10.2026 : A complete fix is held over a GSA run, every constellation is merged.
+ *
+ */
+
+#ifndef NMEA_EPOCH_H_
+#define NMEA_EPOCH_H_
+
+#include "nmea.h"
+
+#ifndef NMEA_EPOCH_MAX_SATS
+#define NMEA_EPOCH_MAX_SATS		48		// Used satellites of all GSA sentences in an epoch.
+#endif
+
+typedef enum {
+	NMEA_FIX_GGA = 0x01,
+	NMEA_FIX_RMC = 0x02,
+	NMEA_FIX_GSA = 0x04,
+	NMEA_FIX_GST = 0x08,
+	NMEA_FIX_VTG = 0x10,
+	NMEA_FIX_GBS = 0x20,
+	NMEA_FIX_ZDA = 0x40,
+}NMEA_fixPart_e;
+
+/*
+*  Fused fix of one epoch. Members are valid when the NMEA_fixPart_e bit of
+*  their source sentence is set in parts. Location and time come from the first
+*  of GGA / RMC, date from RMC or ZDA.
+*/
+typedef struct NMEA_Fix_s {
+	int32_t key;			// Epoch time key, milliseconds since midnight
+	uint8_t parts;			// NMEA_fixPart_e of the merged sentences
+	uint8_t talkerId;		// Talker of the first merged sentence
+
+	NMEA_Time_t time;
+	NMEA_Date_t date;
+	NMEA_Location_t location;
+
+	/* GGA */
+	uint8_t quality;
+	uint8_t satellite_n;
+	float altitude;
+	float separation;
+	float diffAge;
+	int32_t diffStation;
+
+	/* RMC */
+	char status;
+	char posMode;
+	float speed;			// Knots
+	float course;
+	float variation;
+
+	/* GSA, every constellation. hdop from GGA until a GSA is merged. */
+	char opMode;
+	uint8_t navMode;
+	float pdop;
+	float hdop;
+	float vdop;
+	uint8_t sats_n;
+	uint8_t sats[NMEA_EPOCH_MAX_SATS];
+
+	/* GST */
+	float rangeRms;
+	float stdMajor;
+	float stdMinor;
+	float orient;
+	float stdLat;
+	float stdLon;
+	float stdAlt;
+
+	/* VTG */
+	float cogm;
+	float sogk;
+
+	/* GBS */
+	float errLat;
+	float errLon;
+	float errAlt;
+
+	/* ZDA */
+	int32_t hour_offset;
+	int32_t minute_offset;
+}NMEA_Fix_t;
+
+typedef void (*NMEA_FixCallback_t)(const NMEA_Fix_t* fix, void* user);
+
+/*
+*  Assembler context. Holds the open epoch only, no allocations.
+*/
+typedef struct NMEA_Epoch_s {
+	NMEA_FixCallback_t callback;
+	void* user;
+	uint8_t required;		// NMEA_fixPart_e set that completes an epoch
+	bool open;
+	int32_t lastKey;		// Key of the last emitted epoch
+
+	uint32_t emitted;		// Fixes passed to the callback
+	uint32_t incomplete;	// ... of them emitted by a newer time tag or flush
+	uint32_t late;			// Sentences of an already emitted epoch, dropped
+
+	NMEA_Fix_t fix;
+}NMEA_Epoch_t;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * required : NMEA_fixPart_e set that completes an epoch, e.g.
+ * NMEA_FIX_GGA | NMEA_FIX_RMC | NMEA_FIX_GSA. The fix is emitted as soon as
+ * they are merged, or when a sentence with a different time tag arrives. A
+ * GSA that completes the set holds the fix until the next sentence that is
+ * not a GSA, so the GSAs of all constellations are merged. Parts of the epoch
+ * arriving after such an early emit are counted late and dropped, list every
+ * part you need. 0 emits on the time tag change only and drops nothing.
+ */
+void NMEA_Epoch_Init(NMEA_Epoch_t* epoch, uint8_t required, NMEA_FixCallback_t callback, void* user);
+
+/**
+ * Parses and merges one packed sentence. GSA and VTG carry no time, they
+ * join the epoch of the last time tag. Returns 0 if the sentence is not a fix
+ * part, failed to parse or is late.
+ */
+uint8_t NMEA_Epoch_Add(NMEA_Epoch_t* epoch, const NMEA_Message_t* msg);
+
+/* Emits the open epoch, if any has a time tag. Call at the end of a stream. */
+void NMEA_Epoch_Flush(NMEA_Epoch_t* epoch);
+
+/* NMEA_Callback_t adapter, NMEA_Parser_SetCallback(&parser, NMEA_Epoch_Callback, &epoch). */
+void NMEA_Epoch_Callback(const NMEA_Message_t* msg, void* epoch);
+
+#endif /* NMEA_EPOCH_H_ */
@@ -0,0 +1,439 @@
+/*
+ *	nmea_gen.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Synthetic NMEA stream generator for load, benchmark and fuzz testing.
+ *  Produces valid checksummed sentences of every NMEA_payloadId_e type with
+ *  configurable corruption and empty field ratios.
+ *
+ *  16.10.2026 : File is created.
+ *
+ *  16.10.2026 : Epoch period is a fraction stepMs / stepDiv, rates like 3 Hz don't drift.
+ *  Only sentences actually written are counted as corrupted.
+ *
+ *	References:
+ *	[1] u-blox8-M8_ReceiverDescrProtSpec_(UBX-13003221), sentence layouts.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+#include "nmea_gen.h"
+
+#define NMEA_GEN_LINE_LEN	128
+#define NMEA_GEN_DAY_MS		86400000u
+
+static const char* const Gen_Talker[] = {
+	[NMEA_TALKER_GP] = "GP",
+	[NMEA_TALKER_GL] = "GL",
+	[NMEA_TALKER_GA] = "GA",
+	[NMEA_TALKER_GB] = "GB",
+	[NMEA_TALKER_GN] = "GN",
+	[NMEA_TALKER_GQ] = "GQ",
+	[NMEA_TALKER_BD] = "BD",
+	[NMEA_TALKER_GI] = "GI",
+};
+
+static const char* const Gen_Payload[] = {
+	[NMEA_MSG_DTM] = "DTM",
+	[NMEA_MSG_GBQ] = "GBQ",
+	[NMEA_MSG_GBS] = "GBS",
+	[NMEA_MSG_GGA] = "GGA",
+	[NMEA_MSG_GLL] = "GLL",
+	[NMEA_MSG_GLQ] = "GLQ",
+	[NMEA_MSG_GNQ] = "GNQ",
+	[NMEA_MSG_GNS] = "GNS",
+	[NMEA_MSG_GPQ] = "GPQ",
+	[NMEA_MSG_GRS] = "GRS",
+	[NMEA_MSG_GSA] = "GSA",
+	[NMEA_MSG_GST] = "GST",
+	[NMEA_MSG_GSV] = "GSV",
+	[NMEA_MSG_RMC] = "RMC",
+	[NMEA_MSG_TXT] = "TXT",
+	[NMEA_MSG_VLW] = "VLW",
+	[NMEA_MSG_VTG] = "VTG",
+	[NMEA_MSG_ZDA] = "ZDA",
+};
+
+/* GSA / GSV constellations and their NMEA 4.10 system IDs. */
+static const uint8_t Gen_System[][2] = {
+	{ NMEA_TALKER_GP, 1 },
+	{ NMEA_TALKER_GL, 2 },
+	{ NMEA_TALKER_GA, 3 },
+	{ NMEA_TALKER_GB, 4 },
+};
+
+typedef struct Gen_Line_s {
+	char data[NMEA_GEN_LINE_LEN];
+	size_t len;
+}Gen_Line_t;
+
+static uint64_t Gen_Next(NMEA_Gen_t* gen) {
+	/* xorshift64* */
+	gen->state ^= gen->state >> 12;
+	gen->state ^= gen->state << 25;
+	gen->state ^= gen->state >> 27;
+	return gen->state * 0x2545F4914F6CDD1DULL;
+}
+
+static float Gen_Unit(NMEA_Gen_t* gen) {
+	return (float)(Gen_Next(gen) >> 40) / (float)(1 << 24);
+}
+
+static uint32_t Gen_Range(NMEA_Gen_t* gen, uint32_t low, uint32_t high) {
+	return low + (uint32_t)(Gen_Next(gen) % (high - low + 1));
+}
+
+/**
+* Appends ",<value>" to the line. Data fields are left empty with emptyRatio
+* probability, fixed tokens (units, IDs) are always written.
+*/
+static void Gen_Field(NMEA_Gen_t* gen, Gen_Line_t* line, bool data, const char* format, ...) {
+
+	if (line->len + 1 >= NMEA_GEN_LINE_LEN) return;
+	line->data[line->len++] = ',';
+
+	if (data && gen->emptyRatio > 0 && Gen_Unit(gen) < gen->emptyRatio) return;
+
+	va_list args;
+	va_start(args, format);
+	int n = vsnprintf(&line->data[line->len], NMEA_GEN_LINE_LEN - line->len, format, args);
+	va_end(args);
+
+	if (n > 0) line->len += (size_t)n;
+	if (line->len >= NMEA_GEN_LINE_LEN) line->len = NMEA_GEN_LINE_LEN - 1;
+}
+
+static void Gen_Time(NMEA_Gen_t* gen, Gen_Line_t* line) {
+	uint32_t t = gen->timeMs;
+	Gen_Field(gen, line, true, "%02u%02u%02u.%02u", t / 3600000, (t / 60000) % 60, (t / 1000) % 60, (t % 1000) / 10);
+}
+
+static void Gen_Coordinate(NMEA_Gen_t* gen, Gen_Line_t* line, double degrees, bool longitude) {
+	char positive = longitude ? 'E' : 'N';
+	char negative = longitude ? 'W' : 'S';
+	double value = (degrees < 0) ? -degrees : degrees;
+	uint32_t deg = (uint32_t)value;
+	uint32_t minutes = (uint32_t)((value - deg) * 60.0 * 100000.0 + 0.5);	// mm.mmmmm
+
+	if (minutes >= 6000000) {
+		deg++;
+		minutes -= 6000000;
+	}
+
+	if (longitude) Gen_Field(gen, line, true, "%03u%02u.%05u", deg, minutes / 100000, minutes % 100000);
+	else Gen_Field(gen, line, true, "%02u%02u.%05u", deg, minutes / 100000, minutes % 100000);
+	Gen_Field(gen, line, true, "%c", (degrees < 0) ? negative : positive);
+}
+
+static void Gen_Position(NMEA_Gen_t* gen, Gen_Line_t* line) {
+	Gen_Coordinate(gen, line, gen->latitude, false);
+	Gen_Coordinate(gen, line, gen->longitude, true);
+}
+
+static void Gen_Float(NMEA_Gen_t* gen, Gen_Line_t* line, float low, float high, uint8_t decimals) {
+	Gen_Field(gen, line, true, "%.*f", decimals, low + (high - low) * Gen_Unit(gen));
+}
+
+static void Gen_GSV(NMEA_Gen_t* gen, Gen_Line_t* line, uint8_t numMsg, uint8_t msgNum, uint8_t numSV, uint8_t signalId) {
+	Gen_Field(gen, line, false, "%u", numMsg);
+	Gen_Field(gen, line, false, "%u", msgNum);
+	Gen_Field(gen, line, false, "%02u", numSV);
+
+	for (uint8_t i = (uint8_t)((msgNum - 1) * 4); i < numSV && i < msgNum * 4; i++) {
+		Gen_Field(gen, line, false, "%02u", i + 1);
+		Gen_Field(gen, line, true, "%02u", Gen_Range(gen, 5, 90));
+		Gen_Field(gen, line, true, "%03u", Gen_Range(gen, 0, 359));
+		Gen_Field(gen, line, true, "%02u", Gen_Range(gen, 15, 50));
+	}
+	Gen_Field(gen, line, false, "%u", signalId);
+}
+
+/* Payload fields of one sentence, layouts of [1]. */
+static bool Gen_Payload_Fields(NMEA_Gen_t* gen, Gen_Line_t* line, uint8_t talkerId, uint8_t payloadId) {
+
+	uint8_t systemId = 1;
+	for (uint8_t i = 0; i < 4; i++) {
+		if (Gen_System[i][0] == talkerId) systemId = Gen_System[i][1];
+	}
+
+	switch (payloadId) {
+	case(NMEA_MSG_DTM): {
+		Gen_Field(gen, line, false, "W84");
+		Gen_Field(gen, line, false, "");
+		Gen_Float(gen, line, 0, 0, 1);
+		Gen_Field(gen, line, false, "N");
+		Gen_Float(gen, line, 0, 0, 1);
+		Gen_Field(gen, line, false, "E");
+		Gen_Float(gen, line, 0, 0, 1);
+		Gen_Field(gen, line, false, "W84");
+	}break;
+	case(NMEA_MSG_GBQ):
+	case(NMEA_MSG_GLQ):
+	case(NMEA_MSG_GNQ):
+	case(NMEA_MSG_GPQ): {
+		Gen_Field(gen, line, false, "RMC");
+	}break;
+	case(NMEA_MSG_GBS): {
+		Gen_Time(gen, line);
+		Gen_Float(gen, line, 0.5f, 5, 1);
+		Gen_Float(gen, line, 0.5f, 5, 1);
+		Gen_Float(gen, line, 1, 9, 1);
+		Gen_Field(gen, line, true, "%02u", Gen_Range(gen, 1, 32));
+		Gen_Field(gen, line, true, "");
+		Gen_Float(gen, line, -30, 30, 1);
+		Gen_Float(gen, line, 0.5f, 5, 1);
+		Gen_Field(gen, line, false, "%u", systemId);
+		Gen_Field(gen, line, false, "0");
+	}break;
+	case(NMEA_MSG_GGA): {
+		Gen_Time(gen, line);
+		Gen_Position(gen, line);
+		Gen_Field(gen, line, true, "%u", Gen_Range(gen, 1, 2));
+		Gen_Field(gen, line, true, "%02u", Gen_Range(gen, 4, 24));
+		Gen_Float(gen, line, 0.6f, 3, 2);
+		Gen_Float(gen, line, 100, 600, 1);
+		Gen_Field(gen, line, false, "M");
+		Gen_Float(gen, line, 40, 50, 1);
+		Gen_Field(gen, line, false, "M");
+		Gen_Field(gen, line, true, "");
+		Gen_Field(gen, line, true, "");
+	}break;
+	case(NMEA_MSG_GLL): {
+		Gen_Position(gen, line);
+		Gen_Time(gen, line);
+		Gen_Field(gen, line, true, "A");
+		Gen_Field(gen, line, true, "A");
+	}break;
+	case(NMEA_MSG_GNS): {
+		Gen_Time(gen, line);
+		Gen_Position(gen, line);
+		Gen_Field(gen, line, true, "AAAA");
+		Gen_Field(gen, line, true, "%02u", Gen_Range(gen, 4, 24));
+		Gen_Float(gen, line, 0.6f, 3, 2);
+		Gen_Float(gen, line, 100, 600, 1);
+		Gen_Float(gen, line, 40, 50, 1);
+		Gen_Field(gen, line, true, "");
+		Gen_Field(gen, line, true, "");
+		Gen_Field(gen, line, true, "V");
+	}break;
+	case(NMEA_MSG_GRS): {
+		Gen_Time(gen, line);
+		Gen_Field(gen, line, false, "1");
+		for (uint8_t i = 0; i < 12; i++) {
+			if (i < 8) Gen_Float(gen, line, -9, 9, 1);
+			else Gen_Field(gen, line, false, "");
+		}
+		Gen_Field(gen, line, false, "%u", systemId);
+		Gen_Field(gen, line, false, "1");
+	}break;
+	case(NMEA_MSG_GSA): {
+		Gen_Field(gen, line, false, "A");
+		Gen_Field(gen, line, true, "3");
+		for (uint8_t i = 0; i < 12; i++) {
+			if (i < 8) Gen_Field(gen, line, true, "%02u", Gen_Range(gen, 1, 32));
+			else Gen_Field(gen, line, false, "");
+		}
+		Gen_Float(gen, line, 1, 4, 2);
+		Gen_Float(gen, line, 0.6f, 3, 2);
+		Gen_Float(gen, line, 0.8f, 3, 2);
+		Gen_Field(gen, line, false, "%u", systemId);
+	}break;
+	case(NMEA_MSG_GST): {
+		Gen_Time(gen, line);
+		Gen_Float(gen, line, 0.5f, 20, 1);
+		Gen_Float(gen, line, 0.5f, 5, 1);
+		Gen_Float(gen, line, 0.5f, 5, 1);
+		Gen_Float(gen, line, 0, 180, 1);
+		Gen_Float(gen, line, 0.5f, 5, 1);
+		Gen_Float(gen, line, 0.5f, 5, 1);
+		Gen_Float(gen, line, 1, 9, 1);
+	}break;
+	case(NMEA_MSG_GSV): {
+		Gen_GSV(gen, line, 1, 1, 4, 1);
+	}break;
+	case(NMEA_MSG_RMC): {
+		Gen_Time(gen, line);
+		Gen_Field(gen, line, true, "A");
+		Gen_Position(gen, line);
+		Gen_Float(gen, line, 0, 30, 3);
+		Gen_Float(gen, line, 0, 359, 2);
+		Gen_Field(gen, line, true, "%02d%02d%02d", gen->date.day, gen->date.month, gen->date.year % 100);
+		Gen_Field(gen, line, true, "");
+		Gen_Field(gen, line, true, "");
+		Gen_Field(gen, line, true, "A");
+		Gen_Field(gen, line, true, "V");
+	}break;
+	case(NMEA_MSG_TXT): {
+		Gen_Field(gen, line, false, "01");
+		Gen_Field(gen, line, false, "01");
+		Gen_Field(gen, line, false, "02");
+		Gen_Field(gen, line, false, "synthetic stream");
+	}break;
+	case(NMEA_MSG_VLW): {
+		Gen_Field(gen, line, true, "");
+		Gen_Field(gen, line, false, "N");
+		Gen_Field(gen, line, true, "");
+		Gen_Field(gen, line, false, "N");
+		Gen_Float(gen, line, 0, 100, 1);
+		Gen_Field(gen, line, false, "N");
+		Gen_Float(gen, line, 0, 10, 1);
+		Gen_Field(gen, line, false, "N");
+	}break;
+	case(NMEA_MSG_VTG): {
+		Gen_Float(gen, line, 0, 359, 2);
+		Gen_Field(gen, line, false, "T");
+		Gen_Field(gen, line, true, "");
+		Gen_Field(gen, line, false, "M");
+		Gen_Float(gen, line, 0, 30, 3);
+		Gen_Field(gen, line, false, "N");
+		Gen_Float(gen, line, 0, 55, 3);
+		Gen_Field(gen, line, false, "K");
+		Gen_Field(gen, line, true, "A");
+	}break;
+	case(NMEA_MSG_ZDA): {
+		Gen_Time(gen, line);
+		Gen_Field(gen, line, true, "%02d", gen->date.day);
+		Gen_Field(gen, line, true, "%02d", gen->date.month);
+		Gen_Field(gen, line, true, "%04d", gen->date.year);
+		Gen_Field(gen, line, false, "00");
+		Gen_Field(gen, line, false, "00");
+	}break;
+	default: {
+		return false;
+	}break;
+	}
+
+	return true;
+}
+
+/* Closes the line with its checksum, corrupts it with corruptRatio probability. */
+static size_t Gen_Finish(NMEA_Gen_t* gen, Gen_Line_t* line, char* buf, size_t size) {
+
+	if (line->len + 6 > size) return 0;
+
+	line->data[line->len] = '\0';
+	uint8_t checksum = NMEA_Checksum(line->data);
+	bool corrupt = gen->corruptRatio > 0 && Gen_Unit(gen) < gen->corruptRatio;
+
+	if (corrupt) {
+		gen->corrupted++;
+		if (Gen_Next(gen) & 1) checksum ^= (uint8_t)Gen_Range(gen, 1, 255);
+		else {
+			/* Another printable byte, never the one already there. */
+			char* byte = &line->data[Gen_Range(gen, 1, (uint32_t)line->len - 1)];
+			char c = (char)Gen_Range(gen, ' ' + 1, '~' - 1);
+			*byte = (c >= *byte) ? c + 1 : c;
+		}
+	}
+
+	memcpy(buf, line->data, line->len);
+	snprintf(&buf[line->len], 6, "*%02X\r\n", checksum);
+	return line->len + 5;
+}
+
+static size_t Gen_Line(NMEA_Gen_t* gen, Gen_Line_t* line, uint8_t talkerId, uint8_t payloadId, char* buf, size_t size) {
+	line->len = (size_t)snprintf(line->data, NMEA_GEN_LINE_LEN, "$%s%s", Gen_Talker[talkerId], Gen_Payload[payloadId]);
+	if (!Gen_Payload_Fields(gen, line, talkerId, payloadId)) return 0;
+	return Gen_Finish(gen, line, buf, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+void NMEA_Gen_Init(NMEA_Gen_t* gen, uint64_t seed) {
+	memset(gen, 0, sizeof(NMEA_Gen_t));
+
+	gen->state = seed ? seed : 0x9E3779B97F4A7C15ULL;
+	gen->payloadMask = NMEA_GEN_ALL_PAYLOADS;
+	gen->stepMs = 100;
+	gen->stepDiv = 1;
+
+	gen->timeMs = 9 * 3600000u;
+	gen->date.year = 2026;
+	gen->date.month = 10;
+	gen->date.day = 16;
+	gen->latitude = 47.2852331;
+	gen->longitude = 8.5652650;
+}
+
+size_t NMEA_Gen_Sentence(NMEA_Gen_t* gen, uint8_t talkerId, uint8_t payloadId, char* buf, size_t size) {
+	Gen_Line_t line;
+
+	if (talkerId == 0 || talkerId > NMEA_TALKER_GI) return 0;
+	if (payloadId == 0 || payloadId > NMEA_MSG_ZDA) return 0;
+
+	return Gen_Line(gen, &line, talkerId, payloadId, buf, size);
+}
+
+static void Gen_Advance(NMEA_Gen_t* gen) {
+	static const uint8_t days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+	gen->latitude += (Gen_Unit(gen) - 0.5f) * 1e-5;
+	gen->longitude += (Gen_Unit(gen) - 0.5f) * 1e-5;
+	/* stepDiv 0 is taken as 1. */
+	uint32_t div = gen->stepDiv ? gen->stepDiv : 1;
+	uint64_t step = (uint64_t)gen->stepRem + gen->stepMs;
+	gen->timeMs += (uint32_t)(step / div);
+	gen->stepRem = (uint32_t)(step % div);
+
+	if (gen->timeMs < NMEA_GEN_DAY_MS) return;
+
+	gen->timeMs -= NMEA_GEN_DAY_MS;
+	int32_t year = gen->date.year;
+	int32_t last = days[gen->date.month - 1] + ((gen->date.month == 2 && (year % 4 == 0) && (year % 100 != 0 || year % 400 == 0)) ? 1 : 0);
+
+	if (++gen->date.day > last) {
+		gen->date.day = 1;
+		if (++gen->date.month > 12) {
+			gen->date.month = 1;
+			gen->date.year++;
+		}
+	}
+}
+
+size_t NMEA_Gen_Epoch(NMEA_Gen_t* gen, char* buf, size_t size) {
+	Gen_Line_t line;
+	size_t len = 0;
+	size_t n;
+
+	for (uint8_t id = NMEA_MSG_DTM; id <= NMEA_MSG_ZDA; id++) {
+		if (!(gen->payloadMask & (1u << id))) continue;
+
+		if (id == NMEA_MSG_GSA) {
+			for (uint8_t s = 0; s < 4; s++) {
+				if (!(n = Gen_Line(gen, &line, Gen_System[s][0], id, &buf[len], size - len))) goto epoch_end;
+				len += n;
+			}
+			continue;
+		}
+
+		if (id == NMEA_MSG_GSV) {
+			/* Multi-part sky view per constellation. */
+			for (uint8_t s = 0; s < 4; s++) {
+				uint8_t numSV = (uint8_t)Gen_Range(gen, 1, 12);
+				uint8_t numMsg = (uint8_t)((numSV + 3) / 4);
+
+				for (uint8_t msgNum = 1; msgNum <= numMsg; msgNum++) {
+					line.len = (size_t)snprintf(line.data, NMEA_GEN_LINE_LEN, "$%sGSV", Gen_Talker[Gen_System[s][0]]);
+					Gen_GSV(gen, &line, numMsg, msgNum, numSV, 1);
+					if (!(n = Gen_Finish(gen, &line, &buf[len], size - len))) goto epoch_end;
+					len += n;
+				}
+			}
+			continue;
+		}
+
+		if (!(n = Gen_Line(gen, &line, NMEA_TALKER_GN, id, &buf[len], size - len))) goto epoch_end;
+		len += n;
+	}
+
+epoch_end:
+	Gen_Advance(gen);
+	return len;
+}
@@ -0,0 +1,59 @@
+/*
+ *	nmea_gen.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Synthetic NMEA stream generator for load, benchmark and fuzz testing.
+ *  Produces valid checksummed sentences of every NMEA_payloadId_e type with
+ *  configurable corruption and empty field ratios.
+ *
+ *  16.10.2026 : File is created.
+ *
+ *  16.10.2026 : Epoch period is a fraction stepMs / stepDiv, rates like 3 Hz don't drift.
+ *  Only sentences actually written are counted as corrupted.
+ *
+ */
+
+#ifndef NMEA_GEN_H_
+#define NMEA_GEN_H_
+
+#include "nmea.h"
+
+#define NMEA_GEN_ALL_PAYLOADS	0x7FFFEu	// Bit per NMEA_payloadId_e, DTM..ZDA
+
+typedef struct NMEA_Gen_s {
+	uint64_t state;			// xorshift64 state, never 0
+	float corruptRatio;		// Probability of a corrupted sentence (byte flip or bad checksum)
+	float emptyRatio;		// Probability of an empty data field
+	uint32_t payloadMask;	// (1 << payloadId) of the sentences in an epoch
+	uint32_t stepMs;		// Epoch period is stepMs / stepDiv ms, 100 / 1 for 10 Hz, 1000 / 3 for 3 Hz
+	uint32_t stepDiv;
+	uint32_t stepRem;		// Carried remainder of the division, ms * stepDiv
+
+	uint32_t timeMs;		// Epoch time, milliseconds since midnight
+	NMEA_Date_t date;
+	double latitude;		// Degrees, random walk
+	double longitude;
+	uint32_t corrupted;		// Corrupted sentences written
+}NMEA_Gen_t;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+/* 10 Hz, no corruption, no empty fields, every payload type. */
+void NMEA_Gen_Init(NMEA_Gen_t* gen, uint64_t seed);
+
+/**
+ * Writes one "$...*hh\r\n" sentence of the current epoch into buf.
+ * Returns the written length, 0 if buf is too small or the ID is unknown.
+ */
+size_t NMEA_Gen_Sentence(NMEA_Gen_t* gen, uint8_t talkerId, uint8_t payloadId, char* buf, size_t size);
+
+/**
+ * Writes a whole epoch: every payload of payloadMask, GSA / GSV per
+ * constellation (GP, GL, GA, GB), navigation sentences from GN. Advances the
+ * epoch time by stepMs / stepDiv. Returns the written length, stops early if buf is full.
+ */
+size_t NMEA_Gen_Epoch(NMEA_Gen_t* gen, char* buf, size_t size);
+
+#endif /* NMEA_GEN_H_ */
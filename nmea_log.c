@@ -0,0 +1,553 @@
+/*
+ *	nmea_log.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  NMEA log file front-end. Parses recorded NMEA streams on POSIX hosts,
+ *  not intended for the embedded targets of nmea.c.
+ *
+ *  16.10.2026 : File is created. Parallel log ingestion, NMEA_Log_ParseParallel.
+ *
+ *  16.10.2026 : Memory-mapped zero-copy log reader.
+ *
+ *  16.10.2026 : Time index sidecar, seek to a time window.
+ *
+ *  16.10.2026 : NMEA_Log_Init, closing a never opened log is a no-op.
+ *  16.10.2026 : Index skips RMC / ZDA lines cut before the date or time.
+ *  16.10.2026 : NMEA_Log_Next lines end at CR or LF.
+ *  16.10.2026 : ParseParallel lines end at CR or LF, records are written once into the output array.
+ *  16.10.2026 : NMEA_Log_BuildIndex lines end at CR or LF, one line splitter for the whole module.
+ *
+ */
+
+#define _DEFAULT_SOURCE		// madvise
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "nmea_log.h"
+
+#define NMEA_LOG_MAX_THREADS	256
+#define NMEA_LOG_DAY_MS			86400000LL
+#define NMEA_LOG_ABSENT_TIME	{ INT8_MIN, INT8_MIN, INT8_MIN, INT32_MIN }
+#define NMEA_LOG_ABSENT_DATE	{ INT32_MIN, INT32_MIN, INT32_MIN }
+
+typedef struct NMEA_Log_Worker_s {
+	const uint8_t* base;
+	size_t begin;
+	size_t end;
+	uint8_t flags;
+
+	NMEA_Record_t* records;		// Slice of the output array
+	size_t count;
+	size_t capacity;			// '$' in the chunk, no more records can come out of it
+}NMEA_Log_Worker_t;
+
+typedef void* (*NMEA_Log_Task_t)(void* worker);
+
+/* First CR or LF from p, limit if the line is unterminated. CR only logs have no LF to memchr for. */
+static inline const uint8_t* NMEA_Log_LineEnd(const uint8_t* p, const uint8_t* limit) {
+	while (p < limit && *p != '\r' && *p != '\n') p++;
+	return p;
+}
+
+/**
+* Packs the line starting at start. Pack stops at CR/LF, only a last line
+* without terminator is copied, so the packer never reads past the buffer.
+* @param scratch = NMEA_LOG_LINE_LEN bytes, must live as long as msg.
+*/
+static bool NMEA_Log_Pack(NMEA_Parser_t* ctx, NMEA_Message_t* msg, const uint8_t* start, const uint8_t* end, bool terminated, uint8_t* scratch) {
+
+	if (terminated) return NMEA_Parser_Pack(ctx, msg, start);
+
+	size_t len = (size_t)(end - start);
+	if (len >= NMEA_LOG_LINE_LEN) len = NMEA_LOG_LINE_LEN - 1;
+
+	memcpy(scratch, start, len);
+	scratch[len] = '\0';
+	return NMEA_Parser_Pack(ctx, msg, scratch);
+}
+
+static void* NMEA_Log_Count(void* arg) {
+
+	NMEA_Log_Worker_t* worker = arg;
+	const uint8_t* p = &worker->base[worker->begin];
+	const uint8_t* limit = &worker->base[worker->end];
+
+	while (p < limit && (p = memchr(p, '$', (size_t)(limit - p))) != NULL) {
+		worker->capacity++;
+		p++;
+	}
+	return NULL;
+}
+
+static void* NMEA_Log_Worker(void* arg) {
+
+	NMEA_Log_Worker_t* worker = arg;
+	const uint8_t* base = worker->base;
+	const uint8_t* limit = base + worker->end;
+	size_t pos = worker->begin;
+
+	uint8_t scratch[NMEA_LOG_LINE_LEN];
+	NMEA_Parser_t parser;
+	NMEA_Parser_Init(&parser);
+	parser.flags = worker->flags;
+
+	while (pos < worker->end && worker->count < worker->capacity) {
+		const uint8_t* start = memchr(&base[pos], '$', worker->end - pos);
+		if (start == NULL) break;
+
+		const uint8_t* end = NMEA_Log_LineEnd(start, limit);
+
+		NMEA_Message_t msg;
+		NMEA_Record_t* record = &worker->records[worker->count];
+
+		if (NMEA_Log_Pack(&parser, &msg, start, end, end < limit, scratch)) {
+			memset(&record->payload, 0, sizeof(record->payload));
+
+			if (NMEA_Parse(&record->payload, &msg)) {
+				record->offset = (uint64_t)(start - base);
+				record->talkerId = msg.talkerId;
+				record->payloadId = msg.payloadId;
+				worker->count++;
+			}
+		}
+
+		pos = (size_t)(end - base) + 1;
+	}
+
+	return NULL;
+}
+
+/* Runs task on every worker, the calling thread takes the first one and any a thread couldn't start for. */
+static void NMEA_Log_Run(NMEA_Log_Worker_t* worker, uint32_t threads, NMEA_Log_Task_t task) {
+
+	pthread_t thread[NMEA_LOG_MAX_THREADS];
+	bool started[NMEA_LOG_MAX_THREADS];
+
+	for (uint32_t i = 1; i < threads; i++) {
+		started[i] = pthread_create(&thread[i], NULL, task, &worker[i]) == 0;
+	}
+
+	task(&worker[0]);
+
+	for (uint32_t i = 1; i < threads; i++) {
+		if (started[i]) pthread_join(thread[i], NULL);
+		else task(&worker[i]);
+	}
+}
+
+bool NMEA_Log_ParseParallel(const uint8_t* buf, size_t len, uint32_t threads, uint8_t flags,
+	NMEA_Record_t** records, size_t* count) {
+
+	*records = NULL;
+	*count = 0;
+
+	if (threads == 0) {
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = (online > 0) ? (uint32_t)online : 1;
+	}
+	if (threads > NMEA_LOG_MAX_THREADS) threads = NMEA_LOG_MAX_THREADS;
+
+	NMEA_Log_Worker_t worker[NMEA_LOG_MAX_THREADS];
+
+	/* Chunk cuts move forward to the next line start, no sentence is split. */
+	size_t begin = 0;
+	for (uint32_t i = 0; i < threads; i++) {
+		size_t end = (i + 1 == threads) ? len : (size_t)((uint64_t)len * (i + 1) / threads);
+
+		if (end < begin) end = begin;
+		if (end < len) {
+			const uint8_t* cut = NMEA_Log_LineEnd(&buf[end], buf + len);
+			end = (cut < buf + len) ? (size_t)(cut - buf) + 1 : len;
+		}
+
+		memset(&worker[i], 0, sizeof(NMEA_Log_Worker_t));
+		worker[i].base = buf;
+		worker[i].begin = begin;
+		worker[i].end = end;
+		worker[i].flags = flags;
+		begin = end;
+	}
+
+	/* One output array sized by the '$' count, workers fill their slices in place. */
+	NMEA_Log_Run(worker, threads, NMEA_Log_Count);
+
+	size_t capacity = 0;
+	for (uint32_t i = 0; i < threads; i++) capacity += worker[i].capacity;
+	if (capacity == 0) return true;
+
+	NMEA_Record_t* output = malloc(capacity * sizeof(NMEA_Record_t));
+	if (output == NULL) return false;
+
+	size_t offset = 0;
+	for (uint32_t i = 0; i < threads; i++) {
+		worker[i].records = &output[offset];
+		offset += worker[i].capacity;
+	}
+
+	NMEA_Log_Run(worker, threads, NMEA_Log_Worker);
+
+	/* Close the gaps of unparsed lines, moving forward within the same array. */
+	size_t total = 0;
+	for (uint32_t i = 0; i < threads; i++) {
+		if (worker[i].count && worker[i].records != &output[total]) {
+			memmove(&output[total], worker[i].records, worker[i].count * sizeof(NMEA_Record_t));
+		}
+		total += worker[i].count;
+	}
+
+	if (total == 0) {
+		free(output);
+		return true;
+	}
+
+	NMEA_Record_t* shrunk = realloc(output, total * sizeof(NMEA_Record_t));
+	*records = shrunk ? shrunk : output;
+	*count = total;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+void NMEA_Log_Init(NMEA_LogFile_t* log) {
+	memset(log, 0, sizeof(NMEA_LogFile_t));
+	NMEA_Parser_Init(&log->parser);
+	log->fd = -1;
+}
+
+bool NMEA_Log_Open(NMEA_LogFile_t* log, const char* path) {
+
+	struct stat info;
+
+	NMEA_Log_Init(log);
+
+	log->fd = open(path, O_RDONLY);
+	if (log->fd < 0) return false;
+
+	if (fstat(log->fd, &info) != 0) {
+		close(log->fd);
+		log->fd = -1;
+		return false;
+	}
+
+	log->size = (size_t)info.st_size;
+	log->end = log->size;
+	if (log->size == 0) return true;		// Nothing to map, NMEA_Log_Next ends at once.
+
+	void* data = mmap(NULL, log->size, PROT_READ, MAP_PRIVATE, log->fd, 0);
+	if (data == MAP_FAILED) {
+		close(log->fd);
+		log->fd = -1;
+		return false;
+	}
+
+	madvise(data, log->size, MADV_SEQUENTIAL);
+	log->data = data;
+	return true;
+}
+
+void NMEA_Log_Close(NMEA_LogFile_t* log) {
+	if (log->data) munmap((void*)log->data, log->size);
+	if (log->fd >= 0) close(log->fd);
+
+	log->data = NULL;
+	log->size = 0;
+	log->pos = 0;
+	log->end = 0;
+	log->fd = -1;
+}
+
+/* Gives the pages far behind the cursor back, the working set stays bounded. */
+static void NMEA_Log_Release(NMEA_LogFile_t* log) {
+
+	if (log->pos - log->released < 2 * NMEA_LOG_RELEASE_LEN) return;
+
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	size_t end = (log->pos - NMEA_LOG_RELEASE_LEN) & ~(page - 1);
+
+	madvise((void*)&log->data[log->released], end - log->released, MADV_DONTNEED);
+	log->released = end;
+}
+
+bool NMEA_Log_Next(NMEA_LogFile_t* log, NMEA_Message_t* msg) {
+
+	const uint8_t* limit = log->data + log->end;
+
+	while (log->pos < log->end) {
+		const uint8_t* start = memchr(&log->data[log->pos], '$', log->end - log->pos);
+		if (start == NULL) break;
+
+		const uint8_t* end = NMEA_Log_LineEnd(start, limit);
+		bool terminated = end < limit;
+
+		log->pos = (size_t)(end - log->data) + (terminated ? 1 : 0);
+
+		if (NMEA_Log_Pack(&log->parser, msg, start, end, terminated, log->scratch)) {
+			NMEA_Log_Release(log);
+			return true;
+		}
+	}
+
+	log->pos = log->end;
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+int64_t NMEA_Log_TimeKey(const NMEA_Date_t* date, const NMEA_Time_t* time) {
+
+	if (date->year < 0 || time->ms < 0) return -1;
+	if (date->month < 1 || date->month > 12 || date->day < 1 || date->day > 31) return -1;
+
+	/* Days since 1970-01-01, proleptic Gregorian calendar. */
+	int64_t year = date->year - (date->month <= 2);
+	int64_t era = (year >= 0 ? year : year - 399) / 400;
+	int64_t yoe = year - era * 400;
+	int64_t doy = (153 * (date->month + (date->month > 2 ? -3 : 9)) + 2) / 5 + date->day - 1;
+	int64_t days = era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - 719468;
+
+	return days * NMEA_LOG_DAY_MS + time->ms;
+}
+
+/**
+* Key of an index sentence. Undated times continue on the current day; a key
+* about one day behind the previous one is a date lagging the time at
+* midnight (or an undated time of the next day) and moves a day forward.
+*/
+static int64_t NMEA_Log_Index_Key(int64_t* day, int64_t* last, const NMEA_Date_t* date, const NMEA_Time_t* time) {
+
+	static const NMEA_Time_t midnight = { 0, 0, 0, 0 };
+
+	if (time->ms < 0) return -1;
+
+	int64_t start = NMEA_Log_TimeKey(date, &midnight);
+	if (start < 0) start = *day;
+	if (start < 0) return -1;
+
+	int64_t key = start + time->ms;
+
+	if (*last >= 0 && key < *last - NMEA_LOG_DAY_MS / 2 && key + NMEA_LOG_DAY_MS <= *last + NMEA_LOG_DAY_MS / 2) {
+		start += NMEA_LOG_DAY_MS;
+		key += NMEA_LOG_DAY_MS;
+	}
+
+	*day = start;
+	*last = key;
+	return key;
+}
+
+static bool NMEA_Log_Index_Append(NMEA_LogIndex_t* index, size_t* capacity, int64_t time, uint64_t offset) {
+
+	if (index->count == *capacity) {
+		size_t grown = *capacity ? *capacity * 2 : 256;
+		NMEA_LogIndexEntry_t* entries = realloc(index->entries, grown * sizeof(NMEA_LogIndexEntry_t));
+		if (entries == NULL) return false;
+
+		index->entries = entries;
+		*capacity = grown;
+	}
+
+	index->entries[index->count].time = time;
+	index->entries[index->count].offset = offset;
+	index->count++;
+	return true;
+}
+
+bool NMEA_Log_BuildIndex(const NMEA_LogFile_t* log, uint32_t interval, NMEA_LogIndex_t* index) {
+
+	memset(index, 0, sizeof(NMEA_LogIndex_t));
+	index->logSize = log->size;
+	index->interval = interval ? interval : NMEA_LOG_INDEX_INTERVAL;
+
+	const uint8_t* base = log->data;
+	const uint8_t* limit = base + log->size;
+	size_t capacity = 0;
+	size_t pos = 0;
+	size_t epoch = 0;		// First line after the last timed RMC / ZDA
+	int64_t epochKey = -1;
+	int64_t day = -1;
+	int64_t last = -1;
+
+	uint8_t scratch[NMEA_LOG_LINE_LEN];
+	NMEA_Parser_t parser;
+	NMEA_Parser_Init(&parser);
+	parser.flags = log->parser.flags;
+
+	while (pos < log->size) {
+		const uint8_t* start = memchr(&base[pos], '$', log->size - pos);
+		if (start == NULL) break;
+
+		const uint8_t* end = NMEA_Log_LineEnd(start, limit);
+		bool terminated = end < limit;
+		size_t next = terminated ? (size_t)(end - base) + 1 : log->size;
+
+		/* Talker and payload ID checked in place, other sentences aren't packed. */
+		if (end - start > 6 && (memcmp(&start[3], "RMC", 3) == 0 || memcmp(&start[3], "ZDA", 3) == 0)) {
+			NMEA_Message_t msg;
+			NMEA_Date_t date;
+			NMEA_Time_t time;
+			bool ok = false;
+
+			/* Fields past the end of a short line are left untouched by the parsers,
+			   these marks tell them from empty fields (-1). */
+			if (NMEA_Log_Pack(&parser, &msg, start, end, terminated, scratch)) {
+				if (msg.payloadId == NMEA_MSG_RMC) {
+					NMEA_Payload_RMC_t rmc = { .time = NMEA_LOG_ABSENT_TIME, .date = NMEA_LOG_ABSENT_DATE };
+					ok = NMEA_RMC_ParseMask(&rmc, &msg, NMEA_RMC_TIME | NMEA_RMC_DATE);
+					date = rmc.date;
+					time = rmc.time;
+				}
+				else if (msg.payloadId == NMEA_MSG_ZDA) {
+					NMEA_Payload_ZDA_t zda = { .time = NMEA_LOG_ABSENT_TIME, .date = NMEA_LOG_ABSENT_DATE };
+					ok = NMEA_ZDA_ParseMask(&zda, &msg, NMEA_ZDA_TIME | NMEA_ZDA_DATE);
+					date = zda.date;
+					time = zda.time;
+				}
+				ok = ok && time.ms != INT32_MIN && date.year != INT32_MIN;
+			}
+
+			int64_t key = ok ? NMEA_Log_Index_Key(&day, &last, &date, &time) : -1;
+
+			/* A new key starts an epoch after the last timed sentence of the previous one. */
+			if (key >= 0) {
+				const NMEA_LogIndexEntry_t* previous = index->count ? &index->entries[index->count - 1] : NULL;
+
+				if (key != epochKey && (previous == NULL || key >= previous->time + index->interval)) {
+					if (!NMEA_Log_Index_Append(index, &capacity, key, epoch)) {
+						NMEA_LogIndex_Free(index);
+						return false;
+					}
+				}
+				epochKey = key;
+				epoch = next;
+			}
+		}
+
+		pos = next;
+	}
+
+	return true;
+}
+
+void NMEA_LogIndex_Free(NMEA_LogIndex_t* index) {
+	free(index->entries);
+	index->entries = NULL;
+	index->count = 0;
+}
+
+static bool NMEA_Log_WriteAll(int fd, const void* buf, size_t len) {
+	const uint8_t* p = buf;
+	while (len) {
+		ssize_t n = write(fd, p, len);
+		if (n <= 0) return false;
+		p += n;
+		len -= (size_t)n;
+	}
+	return true;
+}
+
+static bool NMEA_Log_ReadAll(int fd, void* buf, size_t len) {
+	uint8_t* p = buf;
+	while (len) {
+		ssize_t n = read(fd, p, len);
+		if (n <= 0) return false;
+		p += n;
+		len -= (size_t)n;
+	}
+	return true;
+}
+
+bool NMEA_LogIndex_Save(const NMEA_LogIndex_t* index, const char* path) {
+
+	NMEA_LogIndexHeader_t header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "NMIX", 4);
+	header.version = NMEA_LOG_INDEX_VERSION;
+	header.byteOrder = 0x0102;
+	header.interval = index->interval;
+	header.logSize = index->logSize;
+	header.count = index->count;
+
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) return false;
+
+	bool ok = NMEA_Log_WriteAll(fd, &header, sizeof(header))
+		&& NMEA_Log_WriteAll(fd, index->entries, index->count * sizeof(NMEA_LogIndexEntry_t));
+
+	if (close(fd) != 0) ok = false;
+	return ok;
+}
+
+bool NMEA_LogIndex_Load(NMEA_LogIndex_t* index, const char* path) {
+
+	NMEA_LogIndexHeader_t header;
+	struct stat info;
+
+	memset(index, 0, sizeof(NMEA_LogIndex_t));
+
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) return false;
+
+	bool ok = fstat(fd, &info) == 0 && NMEA_Log_ReadAll(fd, &header, sizeof(header))
+		&& memcmp(header.magic, "NMIX", 4) == 0
+		&& header.version == NMEA_LOG_INDEX_VERSION
+		&& header.byteOrder == 0x0102
+		&& (uint64_t)info.st_size == sizeof(header) + header.count * sizeof(NMEA_LogIndexEntry_t);
+
+	if (ok && header.count) {
+		index->entries = malloc(header.count * sizeof(NMEA_LogIndexEntry_t));
+		ok = index->entries && NMEA_Log_ReadAll(fd, index->entries, header.count * sizeof(NMEA_LogIndexEntry_t));
+	}
+	close(fd);
+
+	if (!ok) {
+		NMEA_LogIndex_Free(index);
+		return false;
+	}
+
+	index->logSize = header.logSize;
+	index->interval = header.interval;
+	index->count = header.count;
+	return true;
+}
+
+/* First entry with a key above time. */
+static size_t NMEA_Log_Index_Upper(const NMEA_LogIndex_t* index, int64_t time) {
+	size_t lo = 0, hi = index->count;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (index->entries[mid].time <= time) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+bool NMEA_Log_Seek(NMEA_LogFile_t* log, const NMEA_LogIndex_t* index, int64_t from, int64_t to) {
+
+	if (index->logSize != log->size) return false;
+
+	size_t first = NMEA_Log_Index_Upper(index, from);
+	size_t last = NMEA_Log_Index_Upper(index, to);
+
+	size_t begin = first ? (size_t)index->entries[first - 1].offset : 0;
+	size_t end = (last < index->count) ? (size_t)index->entries[last].offset : log->size;
+
+	if (begin > log->size) begin = log->size;
+	if (end > log->size) end = log->size;
+	if (end < begin) end = begin;
+
+	/* Release restarts at the new cursor. */
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	log->released = begin & ~(page - 1);
+	log->pos = begin;
+	log->end = end;
+	return true;
+}
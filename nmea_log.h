@@ -0,0 +1,161 @@
+/*
+ *	nmea_log.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  NMEA log file front-end. Parses recorded NMEA streams on POSIX hosts,
+ *  not intended for the embedded targets of nmea.c.
+ *
+ *  16.10.2026 : File is created. Parallel log ingestion, NMEA_Log_ParseParallel.
+ *
+ *  16.10.2026 : Memory-mapped zero-copy log reader.
+ *
+ *  16.10.2026 : Time index sidecar, seek to a time window.
+ *
+ *  16.10.2026 : NMEA_Log_Init, closing a never opened log is a no-op.
+ *
+ *  16.10.2026 : NMEA_Log_Next lines end at CR or LF.
+ *
+ *  16.10.2026 : ParseParallel lines end at CR or LF, records are written once into the output array.
+ *
+ *  16.10.2026 : NMEA_Log_BuildIndex lines end at CR or LF, one line splitter for the whole module.
+ *
+ */
+
+#ifndef NMEA_LOG_H_
+#define NMEA_LOG_H_
+
+#include "nmea.h"
+
+#define NMEA_LOG_LINE_LEN		256					// NMEA_Parser_Pack limit, scratch of unterminated lines.
+#define NMEA_LOG_RELEASE_LEN	(64u * 1024 * 1024)	// Mapped bytes behind the cursor given back at once.
+#define NMEA_LOG_INDEX_INTERVAL	60000				// Default index spacing, ms. About 23 KB per logged day.
+#define NMEA_LOG_INDEX_VERSION	1
+
+/*
+*  Memory-mapped log. Message views point straight into the mapping.
+*/
+typedef struct NMEA_LogFile_s {
+	NMEA_Parser_t parser;		// Packing statistics & flags (NMEA_PARSER_CHECKSUM)
+
+	const uint8_t* data;
+	size_t size;
+	size_t pos;				// Next unread byte
+	size_t end;				// NMEA_Log_Next stops here, the log size unless a window is set
+	size_t released;		// Bytes behind the cursor already released
+	int fd;
+
+	uint8_t scratch[NMEA_LOG_LINE_LEN];		// Copy of an unterminated last line
+}NMEA_LogFile_t;
+
+/*
+*  One parsed sentence of a log.
+*/
+typedef struct NMEA_Record_s {
+	uint64_t offset;		// Byte offset of the '$' in the log
+	uint8_t talkerId;
+	uint8_t payloadId;
+	NMEA_Payload_t payload;
+}NMEA_Record_t;
+
+/*
+*  Time index of a log. Keys are milliseconds since 1970-01-01 UTC, see
+*  NMEA_Log_TimeKey; offsets point at the first sentence of the epoch whose
+*  RMC / ZDA carried the key.
+*/
+typedef struct NMEA_LogIndexEntry_s {
+	int64_t time;
+	uint64_t offset;
+}NMEA_LogIndexEntry_t;
+
+typedef struct NMEA_LogIndex_s {
+	uint64_t logSize;		// Size of the indexed log, a changed log needs a new index
+	uint32_t interval;		// Minimum key distance of two entries, ms
+	size_t count;
+	NMEA_LogIndexEntry_t* entries;		// Ascending keys, malloc'd
+}NMEA_LogIndex_t;
+
+/*
+*  Sidecar file, header followed by count entries, native byte order.
+*/
+typedef struct NMEA_LogIndexHeader_s {
+	char magic[4];			// "NMIX"
+	uint16_t version;
+	uint16_t byteOrder;		// 0x0102 as written by the host
+	uint32_t interval;
+	uint32_t reserved;
+	uint64_t logSize;
+	uint64_t count;
+}NMEA_LogIndexHeader_t;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Parses a whole log buffer on a pool of threads. The buffer is split into one
+ * chunk per thread at line boundaries (CR or LF), every chunk is parsed
+ * independently with NMEA_Parse. The output is allocated once, sized by the
+ * '$' count of the buffer; workers write into their slice of it and the
+ * slices are packed in place, in log order.
+ * @param threads = Worker count, 0 uses every online core.
+ * @param flags = NMEA_parserFlag_e applied to every worker parser.
+ * @param records = Receives a malloc'd array, release with free().
+ * Returns 0 on allocation failure.
+ */
+bool NMEA_Log_ParseParallel(const uint8_t* buf, size_t len, uint32_t threads, uint8_t flags,
+	NMEA_Record_t** records, size_t* count);
+
+/**
+ * Maps a capture file read-only with a sequential access hint. Files larger
+ * than RAM are fine, pages behind the cursor are released while reading.
+ * Returns 0 if the file can't be opened or mapped.
+ */
+bool NMEA_Log_Open(NMEA_LogFile_t* log, const char* path);
+
+/* Closed state without a file, NMEA_Log_Close on it does nothing. NMEA_Log_Open includes it. */
+void NMEA_Log_Init(NMEA_LogFile_t* log);
+
+/* Unmaps and closes. The log must come from NMEA_Log_Init or NMEA_Log_Open, failed or not. */
+void NMEA_Log_Close(NMEA_LogFile_t* log);
+
+/**
+ * Packs the next sentence of the log, lines end at CR, LF or both. msg->rawdata & msg->payload point into
+ * the mapping and stay valid until NMEA_Log_Close; only an unterminated last
+ * line is copied to log->scratch. Returns 0 at the end of the log.
+ */
+bool NMEA_Log_Next(NMEA_LogFile_t* log, NMEA_Message_t* msg);
+
+/**
+ * Milliseconds since 1970-01-01 UTC of a date and time of day.
+ * Returns -1 if either is empty.
+ */
+int64_t NMEA_Log_TimeKey(const NMEA_Date_t* date, const NMEA_Time_t* time);
+
+/**
+ * Scans the whole log for RMC and ZDA sentences and records an entry every
+ * interval ms of log time. Only those two sentence types are packed and
+ * parsed. RMCs without a date continue from the last known date, a time of
+ * day falling back by more than 12 hours moves to the next day. Keys going
+ * backwards are not indexed until they pass the last entry again.
+ * Doesn't move the read cursor of log.
+ * @param interval = Entry spacing in ms, 0 uses NMEA_LOG_INDEX_INTERVAL.
+ * Returns 0 on allocation failure.
+ */
+bool NMEA_Log_BuildIndex(const NMEA_LogFile_t* log, uint32_t interval, NMEA_LogIndex_t* index);
+void NMEA_LogIndex_Free(NMEA_LogIndex_t* index);
+
+/* Writes / reads the sidecar file of an index. Load refuses other versions and byte orders. */
+bool NMEA_LogIndex_Save(const NMEA_LogIndex_t* index, const char* path);
+bool NMEA_LogIndex_Load(NMEA_LogIndex_t* index, const char* path);
+
+/**
+ * Limits the log to the epochs of [from, to] and moves the cursor to the
+ * first of them; NMEA_Log_Next then reads only that range, which is also
+ * log->data + log->pos up to log->end for NMEA_Log_ParseParallel. The range
+ * is widened to the index entries around it, filter on the parsed time for
+ * exact bounds. INT64_MIN / INT64_MAX select the whole log.
+ * Returns 0 if the index was built for a log of another size.
+ */
+bool NMEA_Log_Seek(NMEA_LogFile_t* log, const NMEA_LogIndex_t* index, int64_t from, int64_t to);
+
+#endif /* NMEA_LOG_H_ */
@@ -0,0 +1,496 @@
+/*
+ *	nmea_pipe.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Pipelined runtime for POSIX hosts. A reader thread frames the raw stream,
+ *  parser workers convert the sentences and consumers pop the records. Stages
+ *  are connected by bounded lock-free rings (C11 atomics), batched, with
+ *  backpressure towards the reader.
+ *
+ *  16.10.2026 : File is created.
+ *
+ *  16.10.2026 : NMEA_Pipe_Start takes the parser flags. Idle stages spin a bounded
+ *  number of times, then block on a condition variable.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "nmea_pipe.h"
+
+#define NMEA_PIPE_POLL_MS	100		// Reader wake up period to see a stop request, longest block of a stage.
+
+typedef bool (*NMEA_PipeReady_t)(const void* arg);
+
+static void* NMEA_Pipe_Alloc(size_t size) {
+	size = (size + NMEA_CACHE_LINE - 1) & ~(size_t)(NMEA_CACHE_LINE - 1);
+	return aligned_alloc(NMEA_CACHE_LINE, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+bool NMEA_Ring_Init(NMEA_Ring_t* ring, size_t capacity, size_t itemSize) {
+	memset(ring, 0, sizeof(NMEA_Ring_t));
+	if (capacity == 0 || (capacity & (capacity - 1))) return false;
+
+	ring->data = NMEA_Pipe_Alloc(capacity * itemSize);
+	ring->mask = capacity - 1;
+	ring->itemSize = itemSize;
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+	return ring->data != NULL;
+}
+
+void NMEA_Ring_Free(NMEA_Ring_t* ring) {
+	free(ring->data);
+	ring->data = NULL;
+}
+
+size_t NMEA_Ring_Push(NMEA_Ring_t* ring, const void* items, size_t n) {
+	size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	size_t capacity = ring->mask + 1;
+
+	if (capacity - (tail - ring->headCache) < n) {
+		ring->headCache = atomic_load_explicit(&ring->head, memory_order_acquire);
+	}
+	size_t space = capacity - (tail - ring->headCache);
+	if (n > space) n = space;
+
+	const uint8_t* src = (const uint8_t*)items;
+	for (size_t i = 0; i < n; i++) {
+		memcpy(&ring->data[((tail + i) & ring->mask) * ring->itemSize], &src[i * ring->itemSize], ring->itemSize);
+	}
+
+	atomic_store_explicit(&ring->tail, tail + n, memory_order_release);
+	return n;
+}
+
+size_t NMEA_Ring_Pop(NMEA_Ring_t* ring, void* items, size_t n) {
+	size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+	if (ring->tailCache - head < n) {
+		ring->tailCache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	}
+	size_t ready = ring->tailCache - head;
+	if (n > ready) n = ready;
+
+	uint8_t* dst = (uint8_t*)items;
+	for (size_t i = 0; i < n; i++) {
+		memcpy(&dst[i * ring->itemSize], &ring->data[((head + i) & ring->mask) * ring->itemSize], ring->itemSize);
+	}
+
+	atomic_store_explicit(&ring->head, head + n, memory_order_release);
+	return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+bool NMEA_Queue_Init(NMEA_Queue_t* queue, size_t capacity, size_t itemSize) {
+	memset(queue, 0, sizeof(NMEA_Queue_t));
+	if (capacity == 0 || (capacity & (capacity - 1))) return false;
+
+	queue->sequence = NMEA_Pipe_Alloc(capacity * sizeof(atomic_size_t));
+	queue->data = NMEA_Pipe_Alloc(capacity * itemSize);
+	queue->mask = capacity - 1;
+	queue->itemSize = itemSize;
+	atomic_init(&queue->head, 0);
+	atomic_init(&queue->tail, 0);
+
+	if (!queue->sequence || !queue->data) {
+		NMEA_Queue_Free(queue);
+		return false;
+	}
+
+	/* Slot i is free for position i. */
+	for (size_t i = 0; i < capacity; i++) atomic_init(&queue->sequence[i], i);
+	return true;
+}
+
+void NMEA_Queue_Free(NMEA_Queue_t* queue) {
+	free(queue->sequence);
+	free(queue->data);
+	queue->sequence = NULL;
+	queue->data = NULL;
+}
+
+/**
+* Claims the run of up to n slots starting at *cursor whose sequence equals
+* position + offset. Returns the claimed count, 0 if the first slot isn't ready.
+*/
+static size_t NMEA_Queue_Claim(NMEA_Queue_t* queue, atomic_size_t* cursor, size_t offset, size_t n, size_t* first) {
+	size_t pos = atomic_load_explicit(cursor, memory_order_relaxed);
+
+	for (;;) {
+		size_t run = 0;
+		while (run < n) {
+			size_t seq = atomic_load_explicit(&queue->sequence[(pos + run) & queue->mask], memory_order_acquire);
+			if (seq != pos + run + offset) break;
+			run++;
+		}
+
+		if (run == 0) {
+			/* Not ready, or another thread took the slot: reload and decide. */
+			size_t seq = atomic_load_explicit(&queue->sequence[pos & queue->mask], memory_order_acquire);
+			size_t now = atomic_load_explicit(cursor, memory_order_relaxed);
+			if (now == pos && (intptr_t)(seq - (pos + offset)) < 0) return 0;
+			pos = now;
+			continue;
+		}
+
+		if (atomic_compare_exchange_weak_explicit(cursor, &pos, pos + run, memory_order_relaxed, memory_order_relaxed)) {
+			*first = pos;
+			return run;
+		}
+	}
+}
+
+size_t NMEA_Queue_Push(NMEA_Queue_t* queue, const void* items, size_t n) {
+	size_t pos;
+	n = NMEA_Queue_Claim(queue, &queue->tail, 0, n, &pos);
+
+	const uint8_t* src = (const uint8_t*)items;
+	for (size_t i = 0; i < n; i++) {
+		size_t slot = (pos + i) & queue->mask;
+		memcpy(&queue->data[slot * queue->itemSize], &src[i * queue->itemSize], queue->itemSize);
+		atomic_store_explicit(&queue->sequence[slot], pos + i + 1, memory_order_release);
+	}
+	return n;
+}
+
+size_t NMEA_Queue_Pop(NMEA_Queue_t* queue, void* items, size_t n) {
+	size_t pos;
+	n = NMEA_Queue_Claim(queue, &queue->head, 1, n, &pos);
+
+	uint8_t* dst = (uint8_t*)items;
+	for (size_t i = 0; i < n; i++) {
+		size_t slot = (pos + i) & queue->mask;
+		memcpy(&dst[i * queue->itemSize], &queue->data[slot * queue->itemSize], queue->itemSize);
+		atomic_store_explicit(&queue->sequence[slot], pos + i + queue->mask + 1, memory_order_release);
+	}
+	return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+static bool NMEA_Event_Init(NMEA_PipeEvent_t* event) {
+	pthread_condattr_t attr;
+	bool ok = false;
+
+	atomic_init(&event->waiters, 0);
+	if (pthread_condattr_init(&attr) != 0) return false;
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+	if (pthread_mutex_init(&event->lock, NULL) == 0) {
+		ok = pthread_cond_init(&event->cond, &attr) == 0;
+		if (!ok) pthread_mutex_destroy(&event->lock);
+	}
+	pthread_condattr_destroy(&attr);
+	return ok;
+}
+
+static void NMEA_Event_Free(NMEA_PipeEvent_t* event) {
+	pthread_cond_destroy(&event->cond);
+	pthread_mutex_destroy(&event->lock);
+}
+
+/* Called after the state change a waiter may be blocked on. */
+static void NMEA_Event_Wake(NMEA_PipeEvent_t* event) {
+	/* Pairs with the fence of NMEA_Event_Wait: either the waiter sees the change or we see the waiter. */
+	atomic_thread_fence(memory_order_seq_cst);
+	if (atomic_load_explicit(&event->waiters, memory_order_relaxed) == 0) return;
+
+	pthread_mutex_lock(&event->lock);
+	pthread_cond_broadcast(&event->cond);
+	pthread_mutex_unlock(&event->lock);
+}
+
+/**
+* Idle step of a stage whose ring was empty / full. Yields for the first
+* NMEA_PIPE_SPIN calls, then blocks until woken or NMEA_PIPE_POLL_MS passed.
+* @param spins = Idle calls in a row, the caller clears it after progress.
+* @param ready = Rechecked under the lock, true if the stage can go on.
+*/
+static void NMEA_Event_Wait(NMEA_PipeEvent_t* event, uint32_t* spins, NMEA_PipeReady_t ready, const void* arg) {
+	if (++*spins < NMEA_PIPE_SPIN) {
+		sched_yield();
+		return;
+	}
+
+	pthread_mutex_lock(&event->lock);
+	atomic_fetch_add_explicit(&event->waiters, 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+
+	if (!ready(arg)) {
+		struct timespec deadline;
+		clock_gettime(CLOCK_MONOTONIC, &deadline);
+		deadline.tv_nsec += NMEA_PIPE_POLL_MS * 1000000L;
+		if (deadline.tv_nsec >= 1000000000L) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+		pthread_cond_timedwait(&event->cond, &event->lock, &deadline);
+	}
+
+	atomic_fetch_sub_explicit(&event->waiters, 1, memory_order_relaxed);
+	pthread_mutex_unlock(&event->lock);
+}
+
+static bool NMEA_Pipe_Stopped(const NMEA_Pipe_t* pipe) {
+	return atomic_load_explicit(&((NMEA_Pipe_t*)pipe)->stop, memory_order_relaxed);
+}
+
+/* Worker can go on: lines to pop, or nothing more will come. */
+static bool NMEA_Pipe_LinesReady(const void* arg) {
+	NMEA_PipeWorker_t* worker = (NMEA_PipeWorker_t*)arg;
+	size_t head = atomic_load_explicit(&worker->lines.head, memory_order_relaxed);
+	size_t tail = atomic_load_explicit(&worker->lines.tail, memory_order_relaxed);
+
+	return tail != head || atomic_load_explicit(&worker->pipe->readerDone, memory_order_relaxed) || NMEA_Pipe_Stopped(worker->pipe);
+}
+
+/* Reader can go on: a free slot in the worker ring. */
+static bool NMEA_Pipe_LinesSpace(const void* arg) {
+	NMEA_PipeWorker_t* worker = (NMEA_PipeWorker_t*)arg;
+	size_t head = atomic_load_explicit(&worker->lines.head, memory_order_relaxed);
+	size_t tail = atomic_load_explicit(&worker->lines.tail, memory_order_relaxed);
+
+	return tail - head <= worker->lines.mask || NMEA_Pipe_Stopped(worker->pipe);
+}
+
+/* Worker can go on: the slot at the queue tail is free. */
+static bool NMEA_Pipe_RecordsSpace(const void* arg) {
+	const NMEA_Pipe_t* pipe = (const NMEA_Pipe_t*)arg;
+	NMEA_Queue_t* queue = (NMEA_Queue_t*)&pipe->records;
+	size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+	return atomic_load_explicit(&queue->sequence[tail & queue->mask], memory_order_relaxed) == tail || NMEA_Pipe_Stopped(pipe);
+}
+
+static void NMEA_Pipe_Pin(pthread_t thread, const int* cpus, uint32_t index) {
+#if defined(__linux__)
+	if (!cpus || cpus[index] < 0) return;
+
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpus[index], &set);
+	pthread_setaffinity_np(thread, sizeof(set), &set);
+#else
+	(void)thread; (void)cpus; (void)index;
+#endif
+}
+
+/* Pushes the whole batch, backpressure: waits while the ring is full. */
+static void NMEA_Pipe_Flush(NMEA_Pipe_t* pipe) {
+	NMEA_PipeWorker_t* worker = &pipe->worker[pipe->target];
+	uint32_t sent = 0;
+	uint32_t spins = 0;
+
+	while (sent < pipe->batched && !atomic_load_explicit(&pipe->stop, memory_order_relaxed)) {
+		size_t n = NMEA_Ring_Push(&worker->lines, &pipe->batch[sent], pipe->batched - sent);
+		if (n == 0) {
+			NMEA_Event_Wait(&worker->space, &spins, NMEA_Pipe_LinesSpace, worker);
+			continue;
+		}
+		NMEA_Event_Wake(&worker->ready);
+		sent += (uint32_t)n;
+		spins = 0;
+	}
+
+	pipe->batched = 0;
+	pipe->target = (pipe->target + 1) % pipe->workers;
+}
+
+static void NMEA_Pipe_Frame(const NMEA_Message_t* msg, void* user) {
+	NMEA_Pipe_t* pipe = (NMEA_Pipe_t*)user;
+	NMEA_PipeLine_t* line = &pipe->batch[pipe->batched++];
+
+	line->sequence = pipe->sequence++;
+	line->length = msg->length;
+	memcpy(line->data, msg->rawdata, msg->length);
+	line->data[msg->length] = '\0';
+
+	if (pipe->batched == NMEA_PIPE_BATCH) NMEA_Pipe_Flush(pipe);
+}
+
+static void* NMEA_Pipe_Reader(void* arg) {
+	NMEA_Pipe_t* pipe = (NMEA_Pipe_t*)arg;
+	uint8_t buf[NMEA_PIPE_READ_LEN];
+	struct pollfd pfd = { .fd = pipe->fd, .events = POLLIN };
+
+	while (!atomic_load_explicit(&pipe->stop, memory_order_relaxed)) {
+		int ready = poll(&pfd, 1, NMEA_PIPE_POLL_MS);
+		if (ready < 0 && errno != EINTR) break;
+		if (ready <= 0) {
+			if (pipe->batched) NMEA_Pipe_Flush(pipe);	// Idle line, don't hold a partial batch
+			continue;
+		}
+
+		ssize_t n = read(pipe->fd, buf, sizeof(buf));
+		if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+		if (n <= 0) break;
+
+		NMEA_Feed(&pipe->parser, buf, (size_t)n);
+	}
+
+	if (pipe->batched) NMEA_Pipe_Flush(pipe);
+	atomic_store_explicit(&pipe->readerDone, true, memory_order_release);
+	for (uint32_t i = 0; i < pipe->workers; i++) NMEA_Event_Wake(&pipe->worker[i].ready);
+	return NULL;
+}
+
+static void* NMEA_Pipe_Worker(void* arg) {
+	NMEA_PipeWorker_t* worker = (NMEA_PipeWorker_t*)arg;
+	NMEA_Pipe_t* pipe = worker->pipe;
+	NMEA_PipeLine_t lines[NMEA_PIPE_BATCH];
+	NMEA_PipeRecord_t records[NMEA_PIPE_BATCH];
+	NMEA_Parser_t parser;
+	NMEA_Message_t msg;
+	uint32_t spins = 0;
+
+	NMEA_Parser_Init(&parser);
+
+	while (!atomic_load_explicit(&pipe->stop, memory_order_relaxed)) {
+		bool done = atomic_load_explicit(&pipe->readerDone, memory_order_acquire);
+		size_t n = NMEA_Ring_Pop(&worker->lines, lines, NMEA_PIPE_BATCH);
+
+		if (n == 0) {
+			if (done) break;	// Reader finished before this empty pop
+			NMEA_Event_Wait(&worker->ready, &spins, NMEA_Pipe_LinesReady, worker);
+			continue;
+		}
+		NMEA_Event_Wake(&worker->space);
+		spins = 0;
+
+		size_t count = 0;
+		for (size_t i = 0; i < n; i++) {
+			NMEA_PipeRecord_t* record = &records[count];
+
+			/* The reader framer applied the pipe flags, the copy is packed as is. */
+			if (!NMEA_Parser_Pack(&parser, &msg, lines[i].data) || !NMEA_Parse(&record->payload, &msg)) {
+				worker->skipped++;
+				continue;
+			}
+			record->sequence = lines[i].sequence;
+			record->talkerId = msg.talkerId;
+			record->payloadId = msg.payloadId;
+			count++;
+		}
+
+		size_t sent = 0;
+		while (sent < count && !atomic_load_explicit(&pipe->stop, memory_order_relaxed)) {
+			size_t pushed = NMEA_Queue_Push(&pipe->records, &records[sent], count - sent);
+			if (pushed == 0) {
+				NMEA_Event_Wait(&pipe->popped, &spins, NMEA_Pipe_RecordsSpace, pipe);
+				continue;
+			}
+			sent += pushed;
+			spins = 0;
+		}
+	}
+
+	atomic_fetch_sub_explicit(&pipe->running, 1, memory_order_release);
+	return NULL;
+}
+
+bool NMEA_Pipe_Start(NMEA_Pipe_t* pipe, int fd, uint32_t workers, uint8_t flags, const int* cpus) {
+	memset(pipe, 0, sizeof(NMEA_Pipe_t));
+	if (workers == 0 || workers > NMEA_PIPE_MAX_WORKERS) return false;
+
+	/* Flags go in before the reader starts, no other thread touches the parser. */
+	NMEA_Parser_Init(&pipe->parser);
+	NMEA_Parser_SetCallback(&pipe->parser, NMEA_Pipe_Frame, pipe);
+	pipe->parser.flags = flags;
+	pipe->fd = fd;
+	pipe->workers = workers;
+	atomic_init(&pipe->stop, false);
+	atomic_init(&pipe->readerDone, false);
+	atomic_init(&pipe->running, 0);
+
+	if (!NMEA_Event_Init(&pipe->popped)) return false;
+	if (!NMEA_Queue_Init(&pipe->records, NMEA_PIPE_RECORDS, sizeof(NMEA_PipeRecord_t))) {
+		NMEA_Event_Free(&pipe->popped);
+		return false;
+	}
+
+	for (uint32_t i = 0; i < workers; i++) {
+		NMEA_PipeWorker_t* worker = &pipe->worker[i];
+		worker->pipe = pipe;
+
+		bool ready = NMEA_Event_Init(&worker->ready);
+		bool space = NMEA_Event_Init(&worker->space);
+
+		if (!ready || !space || !NMEA_Ring_Init(&worker->lines, NMEA_PIPE_LINES, sizeof(NMEA_PipeLine_t)) ||
+			pthread_create(&worker->thread, NULL, NMEA_Pipe_Worker, worker) != 0) {
+			NMEA_Ring_Free(&worker->lines);
+			if (ready) NMEA_Event_Free(&worker->ready);
+			if (space) NMEA_Event_Free(&worker->space);
+			atomic_store(&pipe->readerDone, true);
+			pipe->workers = i;
+			NMEA_Pipe_Stop(pipe);
+			return false;
+		}
+		atomic_fetch_add(&pipe->running, 1);
+		NMEA_Pipe_Pin(worker->thread, cpus, i + 1);
+	}
+
+	if (pthread_create(&pipe->reader, NULL, NMEA_Pipe_Reader, pipe) != 0) {
+		atomic_store(&pipe->readerDone, true);
+		NMEA_Pipe_Stop(pipe);
+		return false;
+	}
+	NMEA_Pipe_Pin(pipe->reader, cpus, 0);
+	return true;
+}
+
+size_t NMEA_Pipe_Pop(NMEA_Pipe_t* pipe, NMEA_PipeRecord_t* records, size_t max) {
+	size_t n = NMEA_Queue_Pop(&pipe->records, records, max);
+	if (n) NMEA_Event_Wake(&pipe->popped);
+	return n;
+}
+
+bool NMEA_Pipe_Running(NMEA_Pipe_t* pipe) {
+	if (atomic_load_explicit(&pipe->running, memory_order_acquire)) return true;
+
+	/* Workers are gone, records pushed before they exited are visible now. */
+	size_t head = atomic_load_explicit(&pipe->records.head, memory_order_acquire);
+	size_t tail = atomic_load_explicit(&pipe->records.tail, memory_order_acquire);
+	return head != tail;
+}
+
+void NMEA_Pipe_Stop(NMEA_Pipe_t* pipe) {
+	atomic_store(&pipe->stop, true);
+
+	/* Blocked stages see the stop now rather than at their timeout. */
+	NMEA_Event_Wake(&pipe->popped);
+	for (uint32_t i = 0; i < pipe->workers; i++) {
+		NMEA_Event_Wake(&pipe->worker[i].ready);
+		NMEA_Event_Wake(&pipe->worker[i].space);
+	}
+
+	if (pipe->reader) pthread_join(pipe->reader, NULL);
+	for (uint32_t i = 0; i < pipe->workers; i++) {
+		pthread_join(pipe->worker[i].thread, NULL);
+		NMEA_Ring_Free(&pipe->worker[i].lines);
+		NMEA_Event_Free(&pipe->worker[i].ready);
+		NMEA_Event_Free(&pipe->worker[i].space);
+	}
+	pipe->reader = 0;
+	pipe->workers = 0;
+
+	/* Stopped twice, the queue & event are gone already. */
+	if (pipe->records.sequence) {
+		NMEA_Queue_Free(&pipe->records);
+		NMEA_Event_Free(&pipe->popped);
+	}
+}
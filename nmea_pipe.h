@@ -0,0 +1,160 @@
+/*
+ *	nmea_pipe.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Pipelined runtime for POSIX hosts. A reader thread frames the raw stream,
+ *  parser workers convert the sentences and consumers pop the records. Stages
+ *  are connected by bounded lock-free rings (C11 atomics), batched, with
+ *  backpressure towards the reader.
+ *
+ *  16.10.2026 : File is created.
+ *
+ *  16.10.2026 : NMEA_Pipe_Start takes the parser flags. Idle stages spin a bounded
+ *  number of times, then block on a condition variable.
+ *
+ */
+
+#ifndef NMEA_PIPE_H_
+#define NMEA_PIPE_H_
+
+#include <stdatomic.h>
+#include <pthread.h>
+#include "nmea.h"
+
+#ifndef NMEA_CACHE_LINE
+#define NMEA_CACHE_LINE			64
+#endif
+
+#define NMEA_PIPE_MAX_WORKERS	32
+#define NMEA_PIPE_BATCH			32		// Items moved per ring operation.
+#define NMEA_PIPE_LINES			1024	// Reader to worker ring, sentences. Power of 2.
+#define NMEA_PIPE_RECORDS		4096	// Worker to consumer queue, records. Power of 2.
+#define NMEA_PIPE_READ_LEN		4096
+#define NMEA_PIPE_SPIN			64		// Empty / full retries of a stage before it blocks.
+
+/*
+*  Single-producer single-consumer ring of fixed size items.
+*  head & tail live on their own cache lines, each side caches the other index.
+*/
+typedef struct NMEA_Ring_s {
+	_Alignas(NMEA_CACHE_LINE) atomic_size_t tail;	// Written by the producer
+	size_t headCache;
+	_Alignas(NMEA_CACHE_LINE) atomic_size_t head;	// Written by the consumer
+	size_t tailCache;
+	_Alignas(NMEA_CACHE_LINE) uint8_t* data;
+	size_t mask;
+	size_t itemSize;
+}NMEA_Ring_t;
+
+/*
+*  Bounded multi-producer multi-consumer queue, per-slot sequence numbers.
+*  Producers and consumers claim contiguous runs of slots with one CAS.
+*/
+typedef struct NMEA_Queue_s {
+	_Alignas(NMEA_CACHE_LINE) atomic_size_t tail;
+	_Alignas(NMEA_CACHE_LINE) atomic_size_t head;
+	_Alignas(NMEA_CACHE_LINE) atomic_size_t* sequence;
+	uint8_t* data;
+	size_t mask;
+	size_t itemSize;
+}NMEA_Queue_t;
+
+/*
+*  Wake up of a blocked stage. The waker takes the lock only if someone waits.
+*/
+typedef struct NMEA_PipeEvent_s {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	atomic_uint waiters;
+}NMEA_PipeEvent_t;
+
+/* Framed sentence, reader to worker. */
+typedef struct NMEA_PipeLine_s {
+	uint64_t sequence;
+	uint8_t length;
+	uint8_t data[NMEA_MAX_MESSAGE_LEN + 1];
+}NMEA_PipeLine_t;
+
+/* Parsed sentence, worker to consumer. sequence restores the stream order. */
+typedef struct NMEA_PipeRecord_s {
+	uint64_t sequence;
+	uint8_t talkerId;
+	uint8_t payloadId;
+	NMEA_Payload_t payload;
+}NMEA_PipeRecord_t;
+
+typedef struct NMEA_Pipe_s NMEA_Pipe_t;
+
+typedef struct NMEA_PipeWorker_s {
+	NMEA_Pipe_t* pipe;
+	NMEA_Ring_t lines;
+	NMEA_PipeEvent_t ready;		// Lines pushed, reader done or stop; the worker waits
+	NMEA_PipeEvent_t space;		// Lines popped or stop; the reader waits
+	pthread_t thread;
+	uint32_t skipped;		// Sentences without parser or failed to parse
+}NMEA_PipeWorker_t;
+
+struct NMEA_Pipe_s {
+	NMEA_Parser_t parser;	// Reader framing statistics & flags (NMEA_PARSER_CHECKSUM)
+	int fd;
+	uint32_t workers;
+	uint64_t sequence;		// Sentences framed by the reader
+
+	atomic_bool stop;
+	atomic_bool readerDone;
+	atomic_uint running;	// Workers still running
+
+	pthread_t reader;
+	NMEA_Queue_t records;
+	NMEA_PipeEvent_t popped;	// Records popped or stop; workers wait on a full queue
+	NMEA_PipeWorker_t worker[NMEA_PIPE_MAX_WORKERS];
+
+	/* Reader side batch of the current worker. */
+	NMEA_PipeLine_t batch[NMEA_PIPE_BATCH];
+	uint32_t batched;
+	uint32_t target;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+/* capacity is a power of 2. Returns 0 on allocation failure. */
+bool NMEA_Ring_Init(NMEA_Ring_t* ring, size_t capacity, size_t itemSize);
+void NMEA_Ring_Free(NMEA_Ring_t* ring);
+
+/* Moves up to n items, returns the moved count, 0 if full / empty. */
+size_t NMEA_Ring_Push(NMEA_Ring_t* ring, const void* items, size_t n);
+size_t NMEA_Ring_Pop(NMEA_Ring_t* ring, void* items, size_t n);
+
+bool NMEA_Queue_Init(NMEA_Queue_t* queue, size_t capacity, size_t itemSize);
+void NMEA_Queue_Free(NMEA_Queue_t* queue);
+size_t NMEA_Queue_Push(NMEA_Queue_t* queue, const void* items, size_t n);
+size_t NMEA_Queue_Pop(NMEA_Queue_t* queue, void* items, size_t n);
+
+/**
+ * Starts the reader on fd and the parser workers.
+ * @param workers = Parser thread count, 1..NMEA_PIPE_MAX_WORKERS.
+ * @param flags = NMEA_parserFlag_e of the reader framer, set before it starts.
+ *  With NMEA_PARSER_CHECKSUM bad sentences never reach a worker.
+ * @param cpus = Optional core of the reader followed by one per worker, -1 unpinned.
+ * Returns 0 if a ring or a thread can't be created.
+ */
+bool NMEA_Pipe_Start(NMEA_Pipe_t* pipe, int fd, uint32_t workers, uint8_t flags, const int* cpus);
+
+/**
+ * Pops up to max records, safe from several consumer threads. Returns 0 if
+ * none is ready; NMEA_Pipe_Running tells if more can come.
+ */
+size_t NMEA_Pipe_Pop(NMEA_Pipe_t* pipe, NMEA_PipeRecord_t* records, size_t max);
+
+/* False once the stream ended, every worker exited and the queue is drained. */
+bool NMEA_Pipe_Running(NMEA_Pipe_t* pipe);
+
+/**
+ * Interrupts every stage, joins the threads and frees the rings. To consume a
+ * whole stream, pop until NMEA_Pipe_Running returns 0 first.
+ */
+void NMEA_Pipe_Stop(NMEA_Pipe_t* pipe);
+
+#endif /* NMEA_PIPE_H_ */
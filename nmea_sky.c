@@ -0,0 +1,117 @@
+/*
+ *	nmea_sky.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  GSV sky view aggregator. Stitches the numMsg / msgNum sequences of every
+ *  constellation into a satellite table indexed by system and SV id.
+ *
+ *  16.10.2026 : File is created.
+ *  16.10.2026 : Sequences are kept per system and signal ID, parts are buffered until complete.
+ *
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "nmea_sky.h"
+
+static const int8_t Sky_System[] = {
+	[0] = -1,
+	[NMEA_TALKER_GP] = NMEA_SKY_GPS,
+	[NMEA_TALKER_GL] = NMEA_SKY_GLONASS,
+	[NMEA_TALKER_GA] = NMEA_SKY_GALILEO,
+	[NMEA_TALKER_GB] = NMEA_SKY_BEIDOU,
+	[NMEA_TALKER_GN] = -1,
+	[NMEA_TALKER_GQ] = NMEA_SKY_QZSS,
+	[NMEA_TALKER_BD] = NMEA_SKY_BEIDOU,
+	[NMEA_TALKER_GI] = NMEA_SKY_NAVIC,
+	[NMEA_TALKER_P] = -1,
+};
+
+void NMEA_Sky_Init(NMEA_Sky_t* sky) {
+	memset(sky, 0, sizeof(NMEA_Sky_t));
+}
+
+/* Swaps the current view of a signal for its assembled sequence. */
+static void Sky_Complete(NMEA_SkyView_t* view, uint8_t signalId) {
+	NMEA_SkySignal_t* signal = &view->signal[signalId];
+	uint16_t bit = (uint16_t)(1u << signalId);
+
+	for (uint8_t i = 0; i < signal->count; i++) {
+		NMEA_SkySat_t* sat = &view->sats[signal->list[i]];
+		sat->signals &= (uint16_t)~bit;
+		sat->snr[signalId] = 0;
+	}
+
+	signal->count = 0;
+	for (uint8_t i = 0; i < signal->pending; i++) {
+		const NMEA_SkyEntry_t* entry = &signal->assembling[i];
+		uint8_t slot = NMEA_Sky_Slot(entry->nr);
+		NMEA_SkySat_t* sat = &view->sats[slot];
+
+		sat->nr = entry->nr;
+		sat->elevation = entry->elevation;
+		sat->azimuth = entry->azimuth;
+		sat->snr[signalId] = entry->snr;
+		sat->signals |= bit;
+		signal->list[signal->count++] = slot;
+	}
+	signal->next = 0;
+
+	view->count = 0;
+	for (uint16_t slot = 1; slot < NMEA_SKY_MAX_SV; slot++) {
+		if (view->sats[slot].signals) view->list[view->count++] = (uint8_t)slot;
+	}
+	view->views++;
+}
+
+uint8_t NMEA_Sky_Add(NMEA_Sky_t* sky, const NMEA_Message_t* msg) {
+	NMEA_Payload_GSV_t frame = { 0 };
+
+	if (msg->talkerId >= sizeof(Sky_System) || Sky_System[msg->talkerId] < 0) return 0;
+	if (!NMEA_GSV_Parse(&frame, msg)) return 0;
+	if (frame.signalId >= NMEA_SKY_SIGNALS) return 0;
+
+	NMEA_SkyView_t* view = &sky->system[Sky_System[msg->talkerId]];
+	NMEA_SkySignal_t* signal = &view->signal[frame.signalId];
+
+	if (frame.msgNum == 1) {
+		signal->numMsg = frame.numMsg;
+		signal->next = 1;
+		signal->pending = 0;
+	}
+
+	if (frame.msgNum == 0 || frame.msgNum != signal->next || frame.numMsg != signal->numMsg) {
+		if (signal->next) sky->dropped++;
+		signal->next = 0;
+		return 0;
+	}
+
+	/* The last part lists the remainder, the trailing signal ID is not a satellite. */
+	int32_t listed = frame.numSV - (frame.msgNum - 1) * 4;
+	if (listed > 4) listed = 4;
+
+	for (int32_t i = 0; i < listed; i++) {
+		if (!NMEA_Sky_Slot(frame.sats[i].nr) || signal->pending >= NMEA_SKY_MAX_VIEW) continue;
+
+		NMEA_SkyEntry_t* entry = &signal->assembling[signal->pending++];
+		entry->nr = (uint16_t)frame.sats[i].nr;
+		entry->elevation = (int8_t)frame.sats[i].elevation;
+		entry->azimuth = (uint16_t)frame.sats[i].azimuth;
+		entry->snr = (uint8_t)frame.sats[i].snr;
+	}
+
+	if (frame.msgNum < frame.numMsg) {
+		signal->next++;
+		return 0;
+	}
+
+	/* Complete: satellites no signal lists any more drop out of view. */
+	Sky_Complete(view, frame.signalId);
+
+	sky->views++;
+	return 1;
+}
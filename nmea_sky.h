@@ -0,0 +1,115 @@
+/*
+ *	nmea_sky.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  GSV sky view aggregator. Stitches the numMsg / msgNum sequences of every
+ *  constellation into a satellite table indexed by system and SV id.
+ *
+ *  16.10.2026 : File is created.
+ *  16.10.2026 : Sequences are kept per system and signal ID, parts are buffered until complete.
+ *
+ */
+
+#ifndef NMEA_SKY_H_
+#define NMEA_SKY_H_
+
+#include "nmea.h"
+
+#define NMEA_SKY_MAX_SV		256		// Table slots per system, SV id 1..255
+#ifndef NMEA_SKY_MAX_VIEW
+#define NMEA_SKY_MAX_VIEW	64		// Satellites listed per signal view
+#endif
+#ifndef NMEA_SKY_SIGNALS
+#define NMEA_SKY_SIGNALS	16		// GSV signal IDs 0..15, 0 for sentences without one
+#endif
+
+/* NMEA_SkySat_t.signals is a 16 bit mask. */
+#if NMEA_SKY_SIGNALS > 16 || NMEA_SKY_SIGNALS < 1
+#error "NMEA_SKY_SIGNALS must be within 1..16"
+#endif
+
+typedef enum {
+	NMEA_SKY_GPS = 0,		// GP talker, GPS / SBAS / QZSS ids of NMEA 4.0
+	NMEA_SKY_GLONASS,		// GL
+	NMEA_SKY_GALILEO,		// GA
+	NMEA_SKY_BEIDOU,		// GB, BD
+	NMEA_SKY_QZSS,			// GQ
+	NMEA_SKY_NAVIC,			// GI
+	NMEA_SKY_SYSTEMS,
+}NMEA_skySystem_e;
+
+typedef struct NMEA_SkySat_s {
+	uint16_t signals;		// Bit n: listed by the current view of signal ID n, 0 if out of view
+	uint16_t nr;			// SV id as reported
+	uint16_t azimuth;
+	int8_t elevation;
+	uint8_t snr[NMEA_SKY_SIGNALS];	// Per signal ID, 0 if not tracked on it
+}NMEA_SkySat_t;
+
+/* One satellite of a GSV part, held until its sequence is complete. */
+typedef struct NMEA_SkyEntry_s {
+	uint16_t nr;
+	uint16_t azimuth;
+	int8_t elevation;
+	uint8_t snr;
+}NMEA_SkyEntry_t;
+
+/*
+*  GSV sequence of one signal. NMEA 4.10 receivers send a sequence per signal
+*  ID, each assembles on its own. list[] holds the table slots of its current
+*  view in reported order.
+*/
+typedef struct NMEA_SkySignal_s {
+	uint8_t numMsg;			// Part count of the assembling sequence
+	uint8_t next;			// Expected msgNum, 0 if idle
+	uint8_t count;			// Satellites in list[]
+	uint8_t pending;		// Satellites in assembling[]
+	uint8_t list[NMEA_SKY_MAX_VIEW];
+	NMEA_SkyEntry_t assembling[NMEA_SKY_MAX_VIEW];
+}NMEA_SkySignal_t;
+
+/*
+*  Sky view of one system, the union of the current views of its signals.
+*  sats[] changes only when a sequence completes; list[] holds the slots in
+*  view in SV id order.
+*/
+typedef struct NMEA_SkyView_s {
+	uint32_t views;			// Completed views, all signals
+	uint8_t count;			// Satellites in list[]
+	uint8_t list[NMEA_SKY_MAX_SV - 1];
+	NMEA_SkySignal_t signal[NMEA_SKY_SIGNALS];
+	NMEA_SkySat_t sats[NMEA_SKY_MAX_SV];
+}NMEA_SkyView_t;
+
+typedef struct NMEA_Sky_s {
+	uint32_t views;			// Completed views, all systems and signals
+	uint32_t dropped;		// Out of sequence parts, the sequence is abandoned
+	NMEA_SkyView_t system[NMEA_SKY_SYSTEMS];
+}NMEA_Sky_t;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+void NMEA_Sky_Init(NMEA_Sky_t* sky);
+
+/**
+ * Parses and merges one GSV part into the sequence of its system and signal ID.
+ * Returns 1 if the part completed a view, 0 otherwise (incomplete, dropped,
+ * not a GSV, signal ID out of range or failed to parse).
+ */
+uint8_t NMEA_Sky_Add(NMEA_Sky_t* sky, const NMEA_Message_t* msg);
+
+/* Table slot of an SV id, Galileo 301.. & BeiDou 401.. ids fold to 1... 0 if invalid. */
+static inline uint8_t NMEA_Sky_Slot(int32_t nr) {
+	if (nr >= 300) nr %= 100;
+	return (nr > 0 && nr < NMEA_SKY_MAX_SV) ? (uint8_t)nr : 0;
+}
+
+/* Satellite in the current view of any signal, NULL if it is not in view. */
+static inline const NMEA_SkySat_t* NMEA_Sky_Sat(const NMEA_Sky_t* sky, uint8_t system, int32_t nr) {
+	const NMEA_SkySat_t* sat = &sky->system[system].sats[NMEA_Sky_Slot(nr)];
+	return sat->signals ? sat : NULL;
+}
+
+#endif /* NMEA_SKY_H_ */
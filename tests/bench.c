@@ -0,0 +1,311 @@
+/*	bench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Microbenchmarks of NMEA_Pack, ID lookup, every parse function and NMEA_Encode. Types
+ *  NMEA_Scan can express are also scanned with the same fields, next to their parser.
+ *  Runs over a mixed u-blox stream built from the test sentences, single thread
+ *  and on every online core. One JSON object per line for release tracking,
+ *  ns_per_sentence is per thread, sentences/bytes per sec are totals.
+ *
+ *  Build : gcc -O2 -I.. ../nmea.c ../nmea_encode.c bench.c -o bench -lpthread
+ *  Usage : bench [rounds] [threads]
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L		// clock_gettime, sysconf under -std=c11
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "nmea.h"
+#include "nmea_encode.h"
+
+#define BENCH_DEFAULT_ROUNDS	200000
+
+/* One u-blox navigation epoch, valid sentences of tests/test.c. */
+static const char* stream_msg[] = {
+	"$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B",
+	"$GPGLL,4717.11364,N,00833.91565,E,092321.00,A,A*60",
+	"$GPGSA,A,3,23,29,07,08,09,18,26,28,,,,,1.94,1.18,1.54,1*0D",
+	"$GPGSV,1,1,03,12,,,42,24,,,47,32,,,37,5*66",
+	"$GPGSV,1,1,03,12,,,42,24,,,47,32,,,37,5*66",
+	"$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*57",
+	"$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06",
+	"$GPZDA,082710.00,16,09,2002,00,00*64",
+	"$GNGBS,170556.00,3.0,2.9,8.3,,,,*5C",
+	"$GPGBS,235458.00,1.4,1.3,3.1,03,,-21.4,3.8,1,0*5B",
+	"$GPGST,082356.00,1.8,,,,1.7,1.3,2.2*7E",
+	"$GNGNS,103600.01,5114.51176,N,00012.29380,W,ANNN,07,1.18,111.5,45.6,,,V*00",
+	"$GNGRS,104148.00,1,2.6,2.2,-1.6,-1.1,-1.7,-1.5,5.8,1.7,,,,,1,1*52",
+	"$GPDTM,W84,,0.0,N,0.0,E,0.0,W84*6F",
+	"$GPVLW,,N,,N,15.8,N,1.2,N*65",
+	"$GPTXT,01,01,02,u-blox ag - www.u-blox.com*50",
+};
+
+#define STREAM_LEN	(sizeof(stream_msg) / sizeof(stream_msg[0]))
+
+typedef enum {
+	BENCH_PACK = 0,
+	BENCH_FIND_ID,
+	BENCH_SCAN,
+	BENCH_PARSE,
+	BENCH_VIEW,
+	BENCH_PARSE_MASK,
+	BENCH_ENCODE,
+}bench_kind_e;
+
+typedef struct bench_s {
+	const char* name;
+	uint8_t kind;
+	uint8_t payloadId;		// BENCH_SCAN / BENCH_PARSE sentence filter, 0 for all
+}bench_t;
+
+static const bench_t bench_list[] = {
+	{ "NMEA_Pack", BENCH_PACK, 0 },
+	{ "NMEA_Find_ID", BENCH_FIND_ID, 0 },
+	{ "NMEA_Parse", BENCH_PARSE, 0 },
+	{ "NMEA_DTM_Parse", BENCH_PARSE, NMEA_MSG_DTM },
+	{ "NMEA_Scan_GBS", BENCH_SCAN, NMEA_MSG_GBS },
+	{ "NMEA_GBS_Parse", BENCH_PARSE, NMEA_MSG_GBS },
+	{ "NMEA_Scan_GGA", BENCH_SCAN, NMEA_MSG_GGA },
+	{ "NMEA_GGA_Parse", BENCH_PARSE, NMEA_MSG_GGA },
+	{ "NMEA_Scan_GLL", BENCH_SCAN, NMEA_MSG_GLL },
+	{ "NMEA_GLL_Parse", BENCH_PARSE, NMEA_MSG_GLL },
+	{ "NMEA_GNS_Parse", BENCH_PARSE, NMEA_MSG_GNS },
+	{ "NMEA_GRS_Parse", BENCH_PARSE, NMEA_MSG_GRS },
+	{ "NMEA_Scan_GSA", BENCH_SCAN, NMEA_MSG_GSA },
+	{ "NMEA_GSA_Parse", BENCH_PARSE, NMEA_MSG_GSA },
+	{ "NMEA_Scan_GST", BENCH_SCAN, NMEA_MSG_GST },
+	{ "NMEA_GST_Parse", BENCH_PARSE, NMEA_MSG_GST },
+	{ "NMEA_GSV_Parse", BENCH_PARSE, NMEA_MSG_GSV },
+	{ "NMEA_Scan_RMC", BENCH_SCAN, NMEA_MSG_RMC },
+	{ "NMEA_RMC_Parse", BENCH_PARSE, NMEA_MSG_RMC },
+	{ "NMEA_TXT_Parse", BENCH_PARSE, NMEA_MSG_TXT },
+	{ "NMEA_Scan_VLW", BENCH_SCAN, NMEA_MSG_VLW },
+	{ "NMEA_VLW_Parse", BENCH_PARSE, NMEA_MSG_VLW },
+	{ "NMEA_Scan_VTG", BENCH_SCAN, NMEA_MSG_VTG },
+	{ "NMEA_VTG_Parse", BENCH_PARSE, NMEA_MSG_VTG },
+	{ "NMEA_Scan_ZDA", BENCH_SCAN, NMEA_MSG_ZDA },
+	{ "NMEA_ZDA_Parse", BENCH_PARSE, NMEA_MSG_ZDA },
+	{ "NMEA_View_RMC_Fix", BENCH_VIEW, NMEA_MSG_RMC },
+	{ "NMEA_RMC_ParseMask_Fix", BENCH_PARSE_MASK, NMEA_MSG_RMC },
+	{ "NMEA_Encode", BENCH_ENCODE, 0 },
+};
+
+/* Holds the workers until all are created, thread start up stays out of the timing. */
+typedef struct bench_gate_s {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	bool open;
+}bench_gate_t;
+
+/* Written once per run by its worker. */
+typedef struct bench_job_s {
+	const bench_t* bench;
+	bench_gate_t* gate;
+	uint32_t rounds;
+	uint64_t sentences;
+	uint64_t bytes;
+	uint32_t sink;
+}bench_job_t;
+
+static NMEA_Message_t stream[STREAM_LEN];
+static NMEA_Payload_t stream_frame[STREAM_LEN];
+static size_t stream_bytes[STREAM_LEN];
+
+static double bench_now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * NMEA_Scan with the members and fields of the NMEA_*_Parse of the type, the
+ * generic baseline of every BENCH_SCAN / BENCH_PARSE pair.
+ */
+static uint8_t bench_scan(NMEA_Payload_t* frame, const NMEA_Message_t* msg) {
+	switch (msg->payloadId) {
+	case(NMEA_MSG_GBS): {
+		NMEA_Payload_GBS_t* f = &frame->gbs;
+		return NMEA_Scan(msg, "Tfffdfff", &f->time, &f->errLat, &f->errLon, &f->errAlt, &f->svid, &f->prob, &f->bias, &f->stddev);
+	}
+	case(NMEA_MSG_GGA): {
+		NMEA_Payload_GGA_t* f = &frame->gga;
+		return NMEA_Scan(msg, "TLqLqiiff_f_fd", &f->time, &f->location.latitude, &f->location.ns_d,
+			&f->location.longitude, &f->location.ew_d, &f->quality, &f->satellite_n, &f->hdop, &f->altitude,
+			&f->separation, &f->diffAge, &f->diffStation);
+	}
+	case(NMEA_MSG_GLL): {
+		NMEA_Payload_GLL_t* f = &frame->gll;
+		return NMEA_Scan(msg, "LqLqTcc", &f->location.latitude, &f->location.ns_d, &f->location.longitude,
+			&f->location.ew_d, &f->time, &f->status, &f->posMode);
+	}
+	case(NMEA_MSG_GSA): {
+		NMEA_Payload_GSA_t* f = &frame->gsa;
+		return NMEA_Scan(msg, "ciiiiiiiiiiiiifffi", &f->opMode, &f->navMode, &f->sats[0], &f->sats[1], &f->sats[2],
+			&f->sats[3], &f->sats[4], &f->sats[5], &f->sats[6], &f->sats[7], &f->sats[8], &f->sats[9], &f->sats[10],
+			&f->sats[11], &f->pdop, &f->hdop, &f->vdop, &f->fix_type);
+	}
+	case(NMEA_MSG_GST): {
+		NMEA_Payload_GST_t* f = &frame->gst;
+		return NMEA_Scan(msg, "Tfffffff", &f->time, &f->rangeRms, &f->stdMajor, &f->stdMinor, &f->orient,
+			&f->stdLat, &f->stdLon, &f->stdAlt);
+	}
+	case(NMEA_MSG_RMC): {
+		NMEA_Payload_RMC_t* f = &frame->rmc;
+		return NMEA_Scan(msg, "TcLqLqffDf_cc", &f->time, &f->status, &f->location.latitude, &f->location.ns_d,
+			&f->location.longitude, &f->location.ew_d, &f->speed, &f->course, &f->date, &f->variation,
+			&f->posMode, &f->navStatus);
+	}
+	case(NMEA_MSG_VLW): {
+		NMEA_Payload_VLW_t* f = &frame->vlw;
+		return NMEA_Scan(msg, "f_f_f_f", &f->twd, &f->wd, &f->tgd, &f->gd);
+	}
+	case(NMEA_MSG_VTG): {
+		NMEA_Payload_VTG_t* f = &frame->vtg;
+		return NMEA_Scan(msg, "f_f_f_f_c", &f->cogt, &f->cogm, &f->sogn, &f->sogk, &f->posMode);
+	}
+	case(NMEA_MSG_ZDA): {
+		NMEA_Payload_ZDA_t* f = &frame->zda;
+		return NMEA_Scan(msg, "Tddddd", &f->time, &f->date.day, &f->date.month, &f->date.year,
+			&f->hour_offset, &f->minute_offset);
+	}
+	default: return 0;
+	}
+}
+
+static void* bench_run(void* arg) {
+	bench_job_t* job = arg;
+	const bench_t* bench = job->bench;
+	uint64_t sentences = 0;
+	uint64_t bytes = 0;
+	uint32_t sink = 0;
+
+	pthread_mutex_lock(&job->gate->lock);
+	while (!job->gate->open) pthread_cond_wait(&job->gate->cond, &job->gate->lock);
+	pthread_mutex_unlock(&job->gate->lock);
+
+	for (uint32_t r = 0; r < job->rounds; r++) {
+		for (size_t i = 0; i < STREAM_LEN; i++) {
+			const NMEA_Message_t* msg = &stream[i];
+			if (bench->payloadId && msg->payloadId != bench->payloadId) continue;
+
+			switch (bench->kind) {
+			case(BENCH_PACK): {
+				NMEA_Message_t temp;
+				sink += NMEA_Pack(&temp, msg->rawdata) + temp.payloadId;
+			}break;
+			case(BENCH_FIND_ID): {
+				sink += NMEA_Find_TalkerID((const char*)&msg->rawdata[1]);
+				sink += NMEA_Find_PayloadID((const char*)&msg->rawdata[3]);
+			}break;
+			case(BENCH_SCAN): {
+				NMEA_Payload_t frame;
+				sink += bench_scan(&frame, msg);
+			}break;
+			case(BENCH_PARSE): {
+				NMEA_Payload_t frame;
+				sink += NMEA_Parse(&frame, msg);
+			}break;
+			case(BENCH_VIEW): {
+				/* Time & position only, the rest of the RMC fields stay unconverted. */
+				NMEA_View_t view;
+				NMEA_Time_t time;
+				int32_t latitude, longitude;
+				NMEA_View_Init(&view, msg);
+				NMEA_View_Time(&view, 0, &time);
+				NMEA_View_Location(&view, 2, &latitude);
+				NMEA_View_Location(&view, 4, &longitude);
+				sink += (uint32_t)(time.ms + latitude + longitude);
+			}break;
+			case(BENCH_PARSE_MASK): {
+				NMEA_Payload_RMC_t frame;
+				sink += NMEA_RMC_ParseMask(&frame, msg, NMEA_RMC_TIME | NMEA_RMC_LOCATION);
+				sink += (uint32_t)frame.location.latitude;
+			}break;
+			case(BENCH_ENCODE): {
+				char sentence[256];
+				sink += (uint32_t)NMEA_Encode(&stream_frame[i], msg->talkerId, msg->payloadId, sentence, sizeof(sentence));
+			}break;
+			}
+
+			sentences++;
+			bytes += stream_bytes[i];
+		}
+	}
+
+	job->sentences = sentences;
+	job->bytes = bytes;
+	job->sink = sink;
+	return NULL;
+}
+
+static void bench_report(const bench_t* bench, uint32_t threads, uint32_t rounds) {
+	bench_job_t job[threads];
+	pthread_t thread[threads];
+	bench_gate_t gate = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, false };
+	uint64_t sentences = 0;
+	uint64_t bytes = 0;
+	uint32_t started = 0;
+
+	memset(job, 0, sizeof(job));
+
+	for (; started < threads; started++) {
+		job[started].bench = bench;
+		job[started].gate = &gate;
+		job[started].rounds = rounds;
+		if (pthread_create(&thread[started], NULL, bench_run, &job[started]) != 0) break;
+	}
+	if (started < threads) fprintf(stderr, "%s: %u of %u threads started\n", bench->name, started, threads);
+	if (!started) return;
+	threads = started;
+
+	double start = bench_now();
+	pthread_mutex_lock(&gate.lock);
+	gate.open = true;
+	pthread_cond_broadcast(&gate.cond);
+	pthread_mutex_unlock(&gate.lock);
+
+	for (uint32_t t = 0; t < threads; t++) {
+		pthread_join(thread[t], NULL);
+		sentences += job[t].sentences;
+		bytes += job[t].bytes;
+	}
+	double elapsed = bench_now() - start;
+
+	printf("{\"bench\":\"%s\",\"threads\":%u,\"sentences\":%llu,\"bytes\":%llu,\"seconds\":%.6f,"
+		"\"ns_per_sentence\":%.2f,\"sentences_per_sec\":%.0f,\"bytes_per_sec\":%.0f}\n",
+		bench->name, threads, (unsigned long long)sentences, (unsigned long long)bytes, elapsed,
+		elapsed * 1e9 * threads / (double)sentences, (double)sentences / elapsed, (double)bytes / elapsed);
+}
+
+int main(int argc, char** argv) {
+
+	uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_ROUNDS;
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	uint32_t threads = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 10) : (cores > 0 ? (uint32_t)cores : 1);
+
+	/* Every rate is divided by the round count. */
+	if (rounds == 0) {
+		fprintf(stderr, "rounds must be at least 1\n");
+		return 1;
+	}
+
+	for (size_t i = 0; i < STREAM_LEN; i++) {
+		NMEA_Pack(&stream[i], (const uint8_t*)stream_msg[i]);
+		NMEA_Parse(&stream_frame[i], &stream[i]);
+		stream_bytes[i] = strlen(stream_msg[i]) + 2;	// Counted with CR LF, as received.
+	}
+
+	for (size_t b = 0; b < sizeof(bench_list) / sizeof(bench_list[0]); b++) {
+		bench_report(&bench_list[b], 1, rounds);
+		if (threads > 1) bench_report(&bench_list[b], threads, rounds);
+	}
+
+	return 0;
+}
@@ -0,0 +1,201 @@
+/*	nmeagen.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: BerkN
+ *
+ *  Synthetic NMEA stream tool on top of nmea_gen. Writes epochs of every
+ *  receiver to stdout, a file or a pseudo terminal, optionally paced at the
+ *  real epoch rate. Replaces recorded logs for load and fuzz testing.
+ *
+ *  Build : gcc -O2 -I.. ../nmea.c ../nmea_gen.c nmeagen.c -o nmeagen
+ *  Usage : nmeagen [-n epochs] [-r rate_hz] [-R receivers] [-c corrupt_ratio]
+ *                  [-e empty_ratio] [-s seed] [-t] [-o file | -p]
+ *          -t : real time pacing at rate_hz
+ *          -o : one file, receivers interleaved by epoch; a path with %u
+ *               (e.g. rx%u.nmea) writes one file per receiver, %% is a '%'
+ *          -p : one pty per receiver, slave names printed to stderr in order
+ *
+ */
+
+#define _XOPEN_SOURCE 600
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include "nmea_gen.h"
+
+#define NMEAGEN_EPOCH_LEN	8192
+
+static int open_pty(void) {
+	int fd = posix_openpt(O_RDWR | O_NOCTTY);
+	if (fd < 0) return -1;
+
+	if (grantpt(fd) != 0 || unlockpt(fd) != 0) {
+		close(fd);
+		return -1;
+	}
+
+	fprintf(stderr, "%s\n", ptsname(fd));
+	return fd;
+}
+
+static int write_all(int fd, const char* buf, size_t len) {
+	while (len) {
+		ssize_t n = write(fd, buf, len);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		buf += n;
+		len -= (size_t)n;
+	}
+	return 0;
+}
+
+static void sleep_until(struct timespec* deadline, long periodNs) {
+	deadline->tv_nsec += periodNs;
+	while (deadline->tv_nsec >= 1000000000L) {
+		deadline->tv_nsec -= 1000000000L;
+		deadline->tv_sec++;
+	}
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL) == EINTR);
+}
+
+/**
+ * File name of receiver r. The path is never a printf format: one %u becomes r,
+ * %% a '%'. Returns the %u count (0 or 1), -1 for any other conversion, a
+ * second %u or a name longer than size.
+ */
+static int expand_path(char* name, size_t size, const char* path, unsigned r) {
+	int receiver = 0;
+	size_t len = 0;
+
+	for (const char* c = path; *c; c++) {
+		char digits[16];
+		const char* text = c;
+		size_t n = 1;
+
+		if (*c == '%') {
+			c++;
+			if (*c == '%') text = c;
+			else if (*c == 'u' && receiver++ == 0) {
+				n = (size_t)snprintf(digits, sizeof(digits), "%u", r);
+				text = digits;
+			}
+			else return -1;
+		}
+
+		if (len + n >= size) return -1;
+		memcpy(&name[len], text, n);
+		len += n;
+	}
+
+	name[len] = '\0';
+	return receiver;
+}
+
+/* Output of receiver r: per receiver pty or file, or the shared one. */
+static int open_output(const char* path, int pty, unsigned r, int shared) {
+	char name[4096];
+
+	if (pty) return open_pty();
+	if (path == NULL) return r ? shared : STDOUT_FILENO;
+
+	int perReceiver = expand_path(name, sizeof(name), path, r);
+	if (perReceiver < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+	if (r && !perReceiver) return shared;
+	return open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+int main(int argc, char** argv) {
+	static char buf[NMEAGEN_EPOCH_LEN];
+
+	unsigned long epochs = 0;		// 0 : endless
+	double rate = 10;
+	unsigned receivers = 1;
+	float corrupt = 0;
+	float empty = 0;
+	uint64_t seed = 1;
+	int pace = 0;
+	const char* path = NULL;
+	int pty = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:r:R:c:e:s:to:p")) != -1) {
+		switch (opt) {
+		case 'n': epochs = strtoul(optarg, NULL, 10); break;
+		case 'r': rate = atof(optarg); break;
+		case 'R': receivers = (unsigned)atoi(optarg); break;
+		case 'c': corrupt = (float)atof(optarg); break;
+		case 'e': empty = (float)atof(optarg); break;
+		case 's': seed = strtoull(optarg, NULL, 0); break;
+		case 't': pace = 1; break;
+		case 'o': path = optarg; break;
+		case 'p': pty = 1; break;
+		default:
+			fprintf(stderr, "usage: %s [-n epochs] [-r rate_hz] [-R receivers] [-c corrupt] [-e empty] [-s seed] [-t] [-o file | -p]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (rate <= 0 || receivers == 0) {
+		fprintf(stderr, "invalid rate or receiver count\n");
+		return 1;
+	}
+
+	char name[4096];
+	if (path && !pty && expand_path(name, sizeof(name), path, 0) < 0) {
+		fprintf(stderr, "invalid output path, only one %%u and %%%% are expanded\n");
+		return 1;
+	}
+
+	NMEA_Gen_t* gen = calloc(receivers, sizeof(NMEA_Gen_t));
+	int* fd = calloc(receivers, sizeof(int));
+	if (gen == NULL || fd == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	for (unsigned r = 0; r < receivers; r++) {
+		fd[r] = open_output(path, pty, r, fd[0]);
+		if (fd[r] < 0) {
+			perror("open");
+			return 1;
+		}
+
+		NMEA_Gen_Init(&gen[r], seed + r);
+		/* 1/1000 Hz resolution, 3 Hz steps 1000000 / 3000 ms without drift. */
+		gen[r].stepMs = 1000000;
+		gen[r].stepDiv = (uint32_t)(rate * 1000.0 + 0.5);
+		gen[r].corruptRatio = corrupt;
+		gen[r].emptyRatio = empty;
+	}
+
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	long periodNs = (long)(1e9 / rate);
+
+	for (unsigned long e = 0; epochs == 0 || e < epochs; e++) {
+		for (unsigned r = 0; r < receivers; r++) {
+			size_t len = NMEA_Gen_Epoch(&gen[r], buf, sizeof(buf));
+			if (write_all(fd[r], buf, len) != 0) {
+				perror("write");
+				return 1;
+			}
+		}
+		if (pace) sleep_until(&deadline, periodNs);
+	}
+
+	for (unsigned r = 0; r < receivers; r++) {
+		if (fd[r] != STDOUT_FILENO && (r == 0 || fd[r] != fd[0])) close(fd[r]);
+	}
+	free(fd);
+	free(gen);
+	return 0;
+}
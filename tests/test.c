@@ -12,20 +12,36 @@
 
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include "nmea.h"
-
-#define MESSAGE_LIST_LEN 10
+#include "nmea_archive.h"
+#include "nmea_batch.h"
+#include "nmea_encode.h"
+#include "nmea_epoch.h"
+#include "nmea_engine.h"
+#include "nmea_log.h"
+#include "nmea_pipe.h"
+#include "nmea_sky.h"
+
+#define MESSAGE_LIST_LEN 15
 #define DEBUG_MODE	
 
 char* valid_msg[] = { 
+	"$GPDTM,W84,,0.0,N,0.0,E,0.0,W84*6F",
 	"$GNGBS,170556.00,3.0,2.9,8.3,,,,*5C",
 	"$GPGBS,235458.00,1.4,1.3,3.1,03,,-21.4,3.8,1,0*5B",
 	"$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B",
 	"$GPGLL,4717.11364,N,00833.91565,E,092321.00,A,A*60",
+	"$GNGNS,103600.01,5114.51176,N,00012.29380,W,ANNN,07,1.18,111.5,45.6,,,V*00",
+	"$GNGRS,104148.00,1,2.6,2.2,-1.6,-1.1,-1.7,-1.5,5.8,1.7,,,,,1,1*52",
 	"$GPGSA,A,3,23,29,07,08,09,18,26,28,,,,,1.94,1.18,1.54,1*0D",
 	"$GPGST,082356.00,1.8,,,,1.7,1.3,2.2*7E",
 	"$GPGSV,1,1,03,12,,,42,24,,,47,32,,,37,5*66",
 	"$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*57",
+	"$GPTXT,01,01,02,u-blox ag - www.u-blox.com*50",
+	"$GPVLW,,N,,N,15.8,N,1.2,N*65",
 	"$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06",
 	"$GPZDA,082710.00,16,09,2002,00,00*64",
 };
@@ -47,25 +63,53 @@ static char* test_msg = "$GNGGA,P9PP2725.00,4717.11399,N,00833.91590,E,1,08,1.01
 
 static NMEA_Message_t temp;
 
+static NMEA_Payload_DTM_t frame_dtm;
 static NMEA_Payload_GBS_t frame_gbs;
 static NMEA_Payload_GGA_t frame_gga;
 static NMEA_Payload_GLL_t frame_gll;
+static NMEA_Payload_GNS_t frame_gns;
+static NMEA_Payload_GRS_t frame_grs;
 static NMEA_Payload_GSA_t frame_gsa;
 static NMEA_Payload_GST_t frame_gst;
 static NMEA_Payload_GSV_t frame_gsv;
 static NMEA_Payload_RMC_t frame_rmc;
+static NMEA_Payload_TXT_t frame_txt;
+static NMEA_Payload_VLW_t frame_vlw;
 static NMEA_Payload_VTG_t frame_vtg;
 static NMEA_Payload_ZDA_t frame_zda;
 
 void nmea_tester(const NMEA_Message_t* test_);
-
+void stream_tester(bool validate);
+void stream_callback(const NMEA_Message_t* msg, void* user);
+void feed_tester(void);
+void feed_case(const char* name, const char* data, size_t chunk, uint8_t flags);
+void dispatch_tester(void);
+void view_tester(void);
+void mask_tester(void);
+void encode_tester(void);
+void epoch_tester(void);
+void batch_tester(void);
+void sky_tester(void);
+void archive_tester(void);
+void log_tester(void);
+void pipe_tester(void);
+void engine_tester(void);
+void engine_handler(const NMEA_Message_t* msg, const NMEA_Payload_t* frame, void* user);
+void epoch_callback(const NMEA_Fix_t* fix, void* user);
+void dispatch_handler(const NMEA_Message_t* msg, const NMEA_Payload_t* frame, void* user);
+
+void print_dtm(const NMEA_Payload_DTM_t* frame);
 void print_gbs(const NMEA_Payload_GBS_t* frame);
 void print_gga(const NMEA_Payload_GGA_t* frame);
 void print_gll(const NMEA_Payload_GLL_t* frame);
+void print_gns(const NMEA_Payload_GNS_t* frame);
+void print_grs(const NMEA_Payload_GRS_t* frame);
 void print_gsa(const NMEA_Payload_GSA_t* frame);
 void print_gst(const NMEA_Payload_GST_t* frame);
 void print_gsv(const NMEA_Payload_GSV_t* frame);
 void print_rmc(const NMEA_Payload_RMC_t* frame);
+void print_txt(const NMEA_Payload_TXT_t* frame);
+void print_vlw(const NMEA_Payload_VLW_t* frame);
 void print_vtg(const NMEA_Payload_VTG_t* frame);
 void print_zda(const NMEA_Payload_ZDA_t* frame);
 
@@ -79,15 +123,565 @@ int main(void) {
 		if (test_msg) nmea_tester(test_msg);
 	}
 
+	stream_tester(false);
+	stream_tester(true);
+	feed_tester();
+	dispatch_tester();
+	view_tester();
+	mask_tester();
+	encode_tester();
+	epoch_tester();
+	batch_tester();
+	sky_tester();
+	archive_tester();
+	log_tester();
+	pipe_tester();
+	engine_tester();
+
 	return 0;
 }
 
+void stream_tester(bool validate) {
+	static char stream[2048];
+	NMEA_Parser_t parser;
+	uint32_t count = 0;
+	size_t len = 0;
+
+	printf("\n--- NMEA STREAM TESTING%s ---\n\n", validate ? " (CHECKSUM)" : "");
+
+	/* Garbage, cut sentence and valid lines, fed in odd sized chunks. */
+	len += sprintf(&stream[len], "\x01\xFFgarbage$GPGSA,A,3,23");
+	for (uint8_t i = 0; i < MESSAGE_LIST_LEN; i++) {
+		len += sprintf(&stream[len], "%s\r\n", valid_msg[i]);
+	}
+	len += sprintf(&stream[len], "$GPGST,082356.00,1.8,,,,1.7,1.3,2.2*7F\r\n");
+	/* Bad trailer digit ahead of the right checksum. */
+	len += sprintf(&stream[len], "$GNGBS,170556.00,3.0,2.9,8.3,,,,*X05C\r\n");
+
+	NMEA_Parser_Init(&parser);
+	NMEA_Parser_SetCallback(&parser, stream_callback, NULL);
+	/* Some receiver manual examples carry a wrong checksum, those are dropped. */
+	if (validate) parser.flags |= NMEA_PARSER_CHECKSUM;
+
+	for (size_t i = 0; i < len; i += 7) {
+		count += NMEA_Feed(&parser, (const uint8_t*)&stream[i], (len - i < 7) ? len - i : 7);
+	}
+
+	printf("FRAMED COUNT : %u\n", count);
+	printf("CHECKSUM ERRORS : %u\n", parser.checksumErrors);
+}
+
+void stream_callback(const NMEA_Message_t* msg, void* user) {
+	(void)user;
+	printf("FRAMED : %s\n", (const char*)msg->rawdata);
+}
+
+void feed_tester(void) {
+	static char overflow[160];
+
+	printf("\n--- NMEA FEED TESTING ---\n\n");
+
+	/* A '$' inside a line starts over, the cut GSA is never framed. */
+	feed_case("RESYNC", "$GPGSA,A,3,23,29$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n", 0, 0);
+	feed_case("CR ONLY", "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r$GPZDA,082710.00,16,09,2002,00,00*64\r", 0, 0);
+	feed_case("LF ONLY", "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\n$GPZDA,082710.00,16,09,2002,00,00*64\n", 0, 0);
+
+	/* Line longer than NMEA_MAX_MESSAGE_LEN is dropped up to the next '$'. */
+	size_t len = (size_t)sprintf(overflow, "$GPTXT,01,01,02,");
+	while (len < NMEA_MAX_MESSAGE_LEN + 20) overflow[len++] = 'X';
+	sprintf(&overflow[len], "*00\r\n$GPZDA,082710.00,16,09,2002,00,00*64\r\n");
+	feed_case("OVERFLOW", overflow, 0, 0);
+
+	/* One byte per call. */
+	feed_case("SPLIT", "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n", 1, 0);
+
+	/* A bad trailer digit stays bad, the valid digits after it don't repair it. */
+	feed_case("BAD DIGIT", "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*X06\r\n$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*0X6\r\n"
+		"$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n", 0, NMEA_PARSER_CHECKSUM);
+}
+
+/* Feeds data in chunk sized calls, 0 : all at once. */
+void feed_case(const char* name, const char* data, size_t chunk, uint8_t flags) {
+	NMEA_Parser_t parser;
+	size_t len = strlen(data);
+	uint32_t count = 0;
+
+	NMEA_Parser_Init(&parser);
+	NMEA_Parser_SetCallback(&parser, stream_callback, NULL);
+	parser.flags = flags;
+
+	printf("%s\n", name);
+	if (chunk == 0) chunk = len;
+	for (size_t i = 0; i < len; i += chunk) {
+		count += NMEA_Feed(&parser, (const uint8_t*)&data[i], (len - i < chunk) ? len - i : chunk);
+	}
+
+	printf("FRAMED COUNT : %u, OVERFLOWS : %u, CHECKSUM ERRORS : %u\n", count, parser.overflows, parser.checksumErrors);
+}
+
+void dispatch_tester(void) {
+	static const char* dispatch_msg[] = {
+		"$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B",
+		"$GNGPQ,RMC*21",
+		"$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*57",
+		"$PUBX,00*33",
+	};
+	NMEA_Parser_t parser;
+	NMEA_Handlers_t handlers;
+
+	printf("\n--- NMEA DISPATCH TESTING ---\n\n");
+
+	/* GPQ has no parser, RMC and proprietary sentences are not registered. */
+	NMEA_Parser_Init(&parser);
+	NMEA_Handlers_Init(&handlers);
+	NMEA_Handlers_Set(&handlers, NMEA_MSG_GGA, dispatch_handler, "GGA");
+	NMEA_Handlers_Set(&handlers, NMEA_MSG_GPQ, dispatch_handler, "GPQ");
+
+	for (uint8_t i = 0; i < sizeof(dispatch_msg) / sizeof(dispatch_msg[0]); i++) {
+		uint8_t called = NMEA_Dispatch(&parser, &handlers, (const uint8_t*)dispatch_msg[i]);
+		printf("DISPATCHED : %d\n", called);
+	}
+}
+
+void dispatch_handler(const NMEA_Message_t* msg, const NMEA_Payload_t* frame, void* user) {
+	printf("HANDLER %s : PAYLOAD ID %d, FRAME %s", (const char*)user, msg->payloadId, frame ? "SET" : "NULL");
+	if (frame && msg->payloadId == NMEA_MSG_GGA) printf(", SATELLITE N %d", frame->gga.satellite_n);
+	printf("\n");
+}
+
+void view_tester(void) {
+	static const char* rmc = "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*57";
+	static const char* gll = "$GPGLL,4717.11364,S,00833.91565,W,092321.00,A,A*6F";
+	NMEA_View_t view;
+	NMEA_Time_t time;
+	NMEA_Date_t date;
+	int32_t location, number;
+	double value;
+	char status;
+
+	printf("\n--- NMEA VIEW TESTING ---\n\n");
+
+	NMEA_Pack(&temp, (const uint8_t*)rmc);
+	NMEA_View_Init(&view, &temp);
+	printf("FIELDS : %d, CACHED : %llx\n", view.fields.count, (unsigned long long)view.cached);
+
+	printf("TIME 0 : %d ", NMEA_View_Time(&view, 0, &time));
+	printf("%02d:%02d:%02d MS %d\n", time.hour, time.min, time.sec, time.ms);
+	printf("CHAR 1 : %d ", NMEA_View_Char(&view, 1, &status));
+	printf("%c\n", status);
+	printf("LOCATION 2 : %d ", NMEA_View_Location(&view, 2, &location));
+	printf("%d\n", location);
+	printf("DOUBLE 6 : %d ", NMEA_View_Double(&view, 6, &value));
+	printf("%f\n", value);
+	printf("DATE 8 : %d ", NMEA_View_Date(&view, 8, &date));
+	printf("%02d.%02d.%d\n", date.day, date.month, date.year);
+	printf("DOUBLE 9 (EMPTY) : %d ", NMEA_View_Double(&view, 9, &value));
+	printf("%f\n", value);
+	printf("CACHED : %llx\n", (unsigned long long)view.cached);
+
+	/* Cached values are returned again, other kinds decode the field anew. */
+	value = 0;
+	printf("DOUBLE 6 (CACHED) : %d ", NMEA_View_Double(&view, 6, &value));
+	printf("%f\n", value);
+	printf("DATE 8 (CACHED) : %d ", NMEA_View_Date(&view, 8, &date));
+	printf("%02d.%02d.%d\n", date.day, date.month, date.year);
+	printf("INT 6 : %d\n", NMEA_View_Int(&view, 6, &number));
+	printf("DOUBLE 1 : %d\n", NMEA_View_Double(&view, 1, &value));
+	printf("INT 8 : %d ", NMEA_View_Int(&view, 8, &number));
+	printf("%d\n", number);
+	printf("DATE 8 (RECACHED) : %d ", NMEA_View_Date(&view, 8, &date));
+	printf("%02d.%02d.%d\n", date.day, date.month, date.year);
+	printf("INT 20 (MISSING) : %d\n", NMEA_View_Int(&view, 20, &number));
+	printf("CACHED : %llx\n", (unsigned long long)view.cached);
+
+	/* S latitude and W longitude are negative. */
+	NMEA_Pack(&temp, (const uint8_t*)gll);
+	NMEA_View_Init(&view, &temp);
+	printf("LOCATION 0 : %d ", NMEA_View_Location(&view, 0, &location));
+	printf("%d\n", location);
+	printf("LOCATION 2 : %d ", NMEA_View_Location(&view, 2, &location));
+	printf("%d\n", location);
+}
+
+void mask_tester(void) {
+	static const char* gga_msg = "$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B";
+	static const char* gsa_msg = "$GPGSA,A,3,23,29,07,08,09,18,26,28,,,,,1.94,1.18,1.54,1*0D";
+	/* Members outside the mask keep these values. */
+	NMEA_Payload_GGA_t gga = {
+		.time = { 99, 99, 99, 99 }, .location = { 99, 99, 99, 99 }, .quality = 99, .satellite_n = 99,
+		.hdop = 99, .altitude = 99, .separation = 99, .diffAge = 99, .diffStation = 99,
+	};
+	NMEA_Payload_GSA_t gsa = {
+		.opMode = 'X', .navMode = 99, .fix_type = 99, .sats = { 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99 },
+		.pdop = 99, .hdop = 99, .vdop = 99,
+	};
+
+	printf("\n--- NMEA MASK TESTING ---\n\n");
+
+	NMEA_Pack(&temp, (const uint8_t*)gga_msg);
+	printf("GGA TIME | LOCATION : %d\n", NMEA_GGA_ParseMask(&gga, &temp, NMEA_GGA_TIME | NMEA_GGA_LOCATION));
+	print_gga(&gga);
+
+	NMEA_Pack(&temp, (const uint8_t*)gsa_msg);
+	printf("GSA DOP : %d\n", NMEA_GSA_ParseMask(&gsa, &temp, NMEA_GSA_DOP));
+	print_gsa(&gsa);
+}
+
+void encode_tester(void) {
+	static char sentence[NMEA_MAX_MESSAGE_LEN + 8];
+	NMEA_Payload_t parsed, reparsed;
+	NMEA_Message_t encoded;
+
+	printf("\n--- NMEA ENCODE TESTING ---\n\n");
+
+	/* Empty numeric fields come back as 0, the parsed structs must still match. */
+	for (uint8_t i = 0; i < MESSAGE_LIST_LEN; i++) {
+		memset(&parsed, 0, sizeof(parsed));
+		memset(&reparsed, 0, sizeof(reparsed));
+
+		NMEA_Pack(&temp, (const uint8_t*)valid_msg[i]);
+		if (!NMEA_Parse(&parsed, &temp)) {
+			printf("PARSE ERROR : %s\n", valid_msg[i]);
+			continue;
+		}
+
+		size_t len = NMEA_Encode(&parsed, temp.talkerId, temp.payloadId, sentence, sizeof(sentence));
+		if (!len) {
+			printf("ENCODE ERROR : %s\n", valid_msg[i]);
+			continue;
+		}
+
+		sentence[len - 2] = '\0';
+		bool same = NMEA_Pack(&encoded, (const uint8_t*)sentence) && NMEA_Parse(&reparsed, &encoded)
+			&& memcmp(&parsed, &reparsed, sizeof(parsed)) == 0;
+		printf("%s : %s\n", same ? "OK" : "MISMATCH", sentence);
+	}
+}
+
+void epoch_tester(void) {
+	/* One GSA per constellation after the required GGA and RMC. */
+	static const char* epoch_msg[] = {
+		"$GNRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*33",
+		"$GNGGA,083559.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*4C",
+		"$GNGSA,A,3,23,29,07,08,,,,,,,,,1.94,1.18,1.54,1*00",
+		"$GNGSA,A,3,65,66,,,,,,,,,,,1.94,1.18,1.54,2*05",
+		"$GNGSA,A,3,13,15,,,,,,,,,,,1.94,1.18,1.54,3*01",
+		"$GNVTG,77.52,T,,M,0.004,N,0.008,K,A*18",
+		"$GNRMC,083600.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A,V*3C",
+		"$GNGGA,083600.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*43",
+		"$GNGSA,A,3,23,29,07,08,,,,,,,,,1.94,1.18,1.54,1*00",
+		"$GNGSA,A,3,65,66,,,,,,,,,,,1.94,1.18,1.54,2*05",
+	};
+	NMEA_Epoch_t epoch;
+
+	printf("\n--- NMEA EPOCH TESTING ---\n\n");
+
+	NMEA_Epoch_Init(&epoch, NMEA_FIX_GGA | NMEA_FIX_RMC | NMEA_FIX_GSA, epoch_callback, NULL);
+	for (uint8_t i = 0; i < sizeof(epoch_msg) / sizeof(epoch_msg[0]); i++) {
+		NMEA_Pack(&temp, (const uint8_t*)epoch_msg[i]);
+		NMEA_Epoch_Add(&epoch, &temp);
+	}
+	NMEA_Epoch_Flush(&epoch);
+
+	printf("EMITTED : %u, INCOMPLETE : %u, LATE : %u\n", epoch.emitted, epoch.incomplete, epoch.late);
+}
+
+void log_tester(void) {
+	/* CR only line ends, RMCs past midnight carry no date. */
+	static const char* log_msg[] = {
+		"$GPRMC,235800.00,A,4717.11437,N,00833.91522,E,0.004,77.52,311225,,,A*57",
+		"$GPGGA,235800.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5C",
+		"$GPRMC,235830.00,A,4717.11437,N,00833.91522,E,0.004,77.52,311225,,,A*54",
+		"$GPGGA,235830.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5F",
+		"$GPRMC,235900.00,A,4717.11437,N,00833.91522,E,0.004,77.52,311225,,,A*56",
+		"$GPGGA,235900.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5D",
+		"$GPRMC,235930.00,A,4717.11437,N,00833.91522,E,0.004,77.52,311225,,,A*55",
+		"$GPGGA,235930.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5E",
+		"$GPRMC,000000.00,A,4717.11437,N,00833.91522,E,0.004,77.52,,,,A*5D",
+		"$GPGGA,000000.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*50",
+		"$GPRMC,000030.00,A,4717.11437,N,00833.91522,E,0.004,77.52,,,,A*5E",
+		"$GPGGA,000030.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*53",
+		"$GPRMC,000100.00,A,4717.11437,N,00833.91522,E,0.004,77.52,,,,A*5C",
+		"$GPGGA,000100.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*51",
+		"$GPRMC,000130.00,A,4717.11437,N,00833.91522,E,0.004,77.52,,,,A*5F",
+		"$GPGGA,000130.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*52",
+		"$GPRMC,000200.00,A,4717.11437,N,00833.91522,E,0.004,77.52,,,,A*5F",
+		"$GPGGA,000200.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*52",
+	};
+	static const char* path = "/tmp/nmea_log_test.nmea";
+	const NMEA_Date_t day = { 2026, 1, 1 };
+	const NMEA_Time_t from = { 0, 0, 30, 30000 };
+	const NMEA_Time_t to = { 0, 1, 0, 60000 };
+	NMEA_LogFile_t log;
+	NMEA_LogIndex_t index;
+	NMEA_Record_t* records;
+	NMEA_Message_t msg;
+	size_t count;
+
+	printf("\n--- NMEA LOG TESTING ---\n\n");
+
+	FILE* file = fopen(path, "wb");
+	if (file == NULL) {
+		printf("LOG : CAN'T WRITE %s\n", path);
+		return;
+	}
+	for (uint8_t i = 0; i < sizeof(log_msg) / sizeof(log_msg[0]); i++) fprintf(file, "%s\r", log_msg[i]);
+	fclose(file);
+
+	if (!NMEA_Log_Open(&log, path)) {
+		printf("LOG : CAN'T OPEN %s\n", path);
+		remove(path);
+		return;
+	}
+
+	for (uint32_t threads = 1; threads <= 3; threads++) {
+		if (!NMEA_Log_ParseParallel(log.data, log.size, threads, 0, &records, &count)) count = 0;
+		printf("PARALLEL : THREADS %u, RECORDS %zu\n", threads, count);
+		free(records);
+	}
+
+	printf("INDEX : %d\n", NMEA_Log_BuildIndex(&log, 0, &index));
+	for (size_t i = 0; i < index.count; i++) {
+		printf("ENTRY : TIME %lld, OFFSET %llu\n", (long long)index.entries[i].time, (unsigned long long)index.entries[i].offset);
+	}
+
+	/* Window after midnight, widened to the entries around it. */
+	printf("SEEK : %d\n", NMEA_Log_Seek(&log, &index, NMEA_Log_TimeKey(&day, &from), NMEA_Log_TimeKey(&day, &to)));
+	while (NMEA_Log_Next(&log, &msg)) {
+		NMEA_Payload_RMC_t rmc;
+		if (msg.payloadId != NMEA_MSG_RMC || !NMEA_RMC_Parse(&rmc, &msg)) continue;
+		printf("RMC : %02d:%02d:%02d\n", rmc.time.hour, rmc.time.min, rmc.time.sec);
+	}
+
+	NMEA_LogIndex_Free(&index);
+	NMEA_Log_Close(&log);
+	remove(path);
+}
+
+void pipe_tester(void) {
+	/* The GGA trailer is wrong, the reader drops it with NMEA_PARSER_CHECKSUM. */
+	static const char* stream = "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n"
+		"$GPGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5C\r\n"
+		"$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n"
+		"$GPZDA,082710.00,16,09,2002,00,00*64\r\n";
+	static NMEA_Pipe_t pipe_;
+	NMEA_PipeRecord_t records[8];
+	NMEA_PipeRecord_t ordered[8];
+	size_t count = 0;
+	int fds[2];
+
+	printf("\n--- NMEA PIPE TESTING ---\n\n");
+
+	if (pipe(fds) != 0) {
+		printf("PIPE : CAN'T CREATE\n");
+		return;
+	}
+	if (write(fds[1], stream, strlen(stream)) != (ssize_t)strlen(stream)) printf("PIPE : SHORT WRITE\n");
+	close(fds[1]);
+
+	printf("START : %d\n", NMEA_Pipe_Start(&pipe_, fds[0], 2, NMEA_PARSER_CHECKSUM, NULL));
+	while (NMEA_Pipe_Running(&pipe_)) {
+		size_t n = NMEA_Pipe_Pop(&pipe_, &records[count], 8 - count);
+		if (n == 0) usleep(1000);
+		count += n;
+	}
+	NMEA_Pipe_Stop(&pipe_);
+	close(fds[0]);
+
+	/* Workers finish out of order, sequence puts the records back. */
+	memset(ordered, 0, sizeof(ordered));
+	for (size_t i = 0; i < count; i++) {
+		if (records[i].sequence < 8) ordered[records[i].sequence] = records[i];
+	}
+
+	printf("FRAMED : %u, CHECKSUM ERRORS : %u, RECORDS : %zu\n", (unsigned)pipe_.sequence, pipe_.parser.checksumErrors, count);
+	for (size_t i = 0; i < count; i++) printf("RECORD : SEQUENCE %u, PAYLOAD %d\n", (unsigned)ordered[i].sequence, ordered[i].payloadId);
+}
+
+void engine_tester(void) {
+	static const char* gga = "$GPGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B\r\n";
+	static const char* rmc = "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n";
+	static const char* vtg = "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n";
+	static NMEA_Engine_t engine;
+
+	printf("\n--- NMEA ENGINE TESTING ---\n\n");
+
+	if (!NMEA_Engine_Init(&engine)) {
+		printf("ENGINE : NO EPOLL\n");
+		return;
+	}
+	NMEA_Handlers_Set(&engine.handlers, NMEA_MSG_GGA, engine_handler, &engine);
+	NMEA_Handlers_Set(&engine.handlers, NMEA_MSG_RMC, engine_handler, &engine);
+
+	int32_t first = NMEA_Engine_Add(&engine, -1, NULL);
+	int32_t second = NMEA_Engine_Add(&engine, -1, NULL);
+	printf("SOURCES : %d %d\n", first, second);
+
+	/* GGA split over two feeds of the second source, the VTG has no handler. */
+	printf("FEED : %u\n", NMEA_Engine_Feed(&engine, (uint32_t)second, (const uint8_t*)gga, 20));
+	printf("FEED : %u\n", NMEA_Engine_Feed(&engine, (uint32_t)first, (const uint8_t*)rmc, strlen(rmc)));
+	printf("FEED : %u\n", NMEA_Engine_Feed(&engine, (uint32_t)second, (const uint8_t*)&gga[20], strlen(gga) - 20));
+	printf("FEED : %u\n", NMEA_Engine_Feed(&engine, (uint32_t)first, (const uint8_t*)vtg, strlen(vtg)));
+
+	/* Out of range and released ids frame nothing. */
+	printf("FEED OUT OF RANGE : %u\n", NMEA_Engine_Feed(&engine, NMEA_ENGINE_MAX_SOURCES, (const uint8_t*)rmc, strlen(rmc)));
+	NMEA_Engine_Remove(&engine, (uint32_t)first);
+	printf("FEED REMOVED : %u\n", NMEA_Engine_Feed(&engine, (uint32_t)first, (const uint8_t*)rmc, strlen(rmc)));
+
+	printf("SOURCES : %u, UNHANDLED : %u\n", engine.sources, engine.unhandled);
+	NMEA_Engine_Close(&engine);
+}
+
+void engine_handler(const NMEA_Message_t* msg, const NMEA_Payload_t* frame, void* user) {
+	int32_t source = NMEA_Engine_Current((const NMEA_Engine_t*)user);
+
+	if (msg->payloadId == NMEA_MSG_GGA) printf("SOURCE %d : GGA SATS %d\n", source, frame->gga.satellite_n);
+	else printf("SOURCE %d : RMC SPEED %f\n", source, frame->rmc.speed);
+}
+
+void batch_tester(void) {
+	/* Cut GGA resynced by the RMC '$', empty ZDA date, a TXT without column set and an unterminated GNS. */
+	static const char* batch_msg = "$GPGGA,092725.00,4717.1$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n"
+		"$GPZDA,082710.00,,,,00,00*6A\r\n"
+		"$GPZDA,082710.00,16,09,2002,00,00*64\n"
+		"$GPVLW,,N,,N,15.8,N,1.2,N*65\r"
+		"$GPTXT,01,01,02,u-blox ag - www.u-blox.com*50\r\n"
+		"$GNGNS,103600.01,5114.51176,N,00012.29380,W,ANNN,07,1.18,111.5,45.6,,,V*00";
+	static NMEA_Batch_t batch;
+	size_t len = strlen(batch_msg);
+
+	printf("\n--- NMEA BATCH TESTING ---\n\n");
+
+	NMEA_Batch_Init(&batch);
+	size_t used = NMEA_ParseBatch(&batch, (const uint8_t*)batch_msg, len);
+	printf("CONSUMED : %zu OF %zu, SKIPPED : %u\n", used, len, batch.skipped);
+	printf("GGA : %u, RMC : %u, ZDA : %u, VLW : %u, GNS : %u\n", batch.gga.count, batch.rmc.count, batch.zda.count, batch.vlw.count, batch.gns.count);
+	printf("RMC : TIME %d, LATITUDE %d, DATE %d\n", batch.rmc.time[0], batch.rmc.latitude[0], batch.rmc.date[0]);
+	for (uint32_t i = 0; i < batch.zda.count; i++) printf("ZDA : TIME %d, DATE %d\n", batch.zda.time[i], batch.zda.date[i]);
+	printf("VLW : TGD %f, GD %f\n", batch.vlw.tgd[0], batch.vlw.gd[0]);
+
+	/* The line end arrives, the GNS goes to its columns. */
+	NMEA_Batch_Clear(&batch);
+	static char rest[128];
+	sprintf(rest, "%s\r\n", &batch_msg[used]);
+	used = NMEA_ParseBatch(&batch, (const uint8_t*)rest, strlen(rest));
+	printf("CONSUMED : %zu OF %zu\n", used, strlen(rest));
+	printf("GNS : COUNT %u, TIME %d, LONGITUDE %d, MODES %s, SV %d, ALTITUDE %f, NAVSTATUS %c\n", batch.gns.count, batch.gns.time[0],
+		batch.gns.longitude[0], batch.gns.posMode[0], batch.gns.numSV[0], batch.gns.altitude[0], batch.gns.navStatus[0]);
+}
+
+void sky_tester(void) {
+	/* GPS signal 1 view in two parts around a signal 8 view, GLONASS starts mid sequence. */
+	static const char* sky_msg[] = {
+		"$GPGSV,2,1,05,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45,1*65",
+		"$GPGSV,1,1,02,01,40,083,30,03,10,100,20,8*63",
+		"$GPGSV,2,2,05,15,10,050,33,1*51",
+		"$GLGSV,2,2,05,70,10,050,33,1*4E",
+		"$GLGSV,1,1,01,65,40,083,30,1*46",
+	};
+	static NMEA_Sky_t sky;
+
+	printf("\n--- NMEA SKY TESTING ---\n\n");
+
+	NMEA_Sky_Init(&sky);
+	for (uint8_t i = 0; i < sizeof(sky_msg) / sizeof(sky_msg[0]); i++) {
+		NMEA_Pack(&temp, (const uint8_t*)sky_msg[i]);
+		printf("ADD : %d\n", NMEA_Sky_Add(&sky, &temp));
+	}
+
+	printf("VIEWS : %u, DROPPED : %u\n", sky.views, sky.dropped);
+	for (uint8_t system = NMEA_SKY_GPS; system <= NMEA_SKY_GLONASS; system++) {
+		const NMEA_SkyView_t* view = &sky.system[system];
+		printf("SYSTEM %d : COUNT %d\n", system, view->count);
+		for (uint8_t i = 0; i < view->count; i++) {
+			const NMEA_SkySat_t* sat = &view->sats[view->list[i]];
+			printf("SAT %d : SIGNALS %04X, ELEVATION %d, AZIMUTH %d, SNR %d %d\n", sat->nr, sat->signals, sat->elevation, sat->azimuth, sat->snr[1], sat->snr[8]);
+		}
+	}
+	printf("SAT 3 IN VIEW : %d, SAT 4 IN VIEW : %d\n", NMEA_Sky_Sat(&sky, NMEA_SKY_GPS, 3) != NULL, NMEA_Sky_Sat(&sky, NMEA_SKY_GPS, 4) != NULL);
+}
+
+void archive_tester(void) {
+	static const char* archive_msg[] = {
+		"$GPGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B",
+		"$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57",
+		"$GNGGA,092726.00,4717.11400,N,00833.91591,E,1,09,1.00,499.8,M,48.0,M,,*4E",
+		"$GPTXT,01,01,02,u-blox ag - www.u-blox.com*50",
+	};
+	static const char* path = "/tmp/nmea_archive_test.nmar";
+	static NMEA_ArchiveWriter_t writer;
+	static NMEA_Archive_t arc;
+	static NMEA_Payload_t written[4];
+	static NMEA_Payload_t frames[4];
+	uint8_t talkerId[4];
+	uint32_t sequence[4];
+	int32_t times[4];
+
+	printf("\n--- NMEA ARCHIVE TESTING ---\n\n");
+
+	if (!NMEA_Archive_Create(&writer, path)) {
+		printf("ARCHIVE : CAN'T CREATE %s\n", path);
+		return;
+	}
+	for (uint8_t i = 0; i < sizeof(archive_msg) / sizeof(archive_msg[0]); i++) {
+		memset(&written[i], 0, sizeof(NMEA_Payload_t));
+		NMEA_Pack(&temp, (const uint8_t*)archive_msg[i]);
+		NMEA_Parse(&written[i], &temp);
+		printf("ADD : %d\n", NMEA_Archive_Add(&writer, temp.talkerId, temp.payloadId, &written[i]));
+	}
+	printf("FINISH : %d\n", NMEA_Archive_Finish(&writer));
+
+	if (!NMEA_Archive_Open(&arc, path)) {
+		printf("ARCHIVE : CAN'T OPEN %s\n", path);
+		remove(path);
+		return;
+	}
+	printf("BLOCKS : %zu, SKIPPED : %zu, TRUNCATED : %d\n", arc.blockCount, arc.skipped, arc.truncated);
+
+	/* Rows come back per type, sequence points at the written frame. */
+	for (size_t b = 0; b < arc.blockCount; b++) {
+		const NMEA_ArchiveBlock_t* block = arc.blocks[b];
+		if (block->rows > 4 || !NMEA_Archive_Read(&arc, b, frames, talkerId, sequence)) {
+			printf("BLOCK %zu : READ ERROR\n", b);
+			continue;
+		}
+		for (uint32_t r = 0; r < block->rows; r++) {
+			bool same = sequence[r] < 4 && memcmp(&frames[r], &written[sequence[r]], sizeof(NMEA_Payload_t)) == 0;
+			printf("BLOCK %zu : PAYLOAD %d, TALKER %d, SEQUENCE %u, %s\n", b, block->payloadId, talkerId[r], sequence[r], same ? "SAME" : "MISMATCH");
+		}
+	}
+
+	/* GGA times through the column API. */
+	int column = NMEA_Archive_FindColumn(NMEA_MSG_GGA, "time");
+	for (size_t b = 0; b < arc.blockCount; b++) {
+		if (arc.blocks[b]->payloadId != NMEA_MSG_GGA || column < 0) continue;
+		if (!NMEA_Archive_Decode(&arc, b, (uint8_t)column, times)) {
+			printf("GGA TIME : NOT DELTA\n");
+			continue;
+		}
+		for (uint32_t r = 0; r < arc.blocks[b]->rows; r++) printf("GGA TIME : %d\n", times[r]);
+	}
+
+	NMEA_Archive_Close(&arc);
+	remove(path);
+}
+
+void epoch_callback(const NMEA_Fix_t* fix, void* user) {
+	(void)user;
+	printf("FIX : KEY %d, PARTS %02X, SATS %d :", fix->key, fix->parts, fix->sats_n);
+	for (uint8_t i = 0; i < fix->sats_n; i++) printf(" %d", fix->sats[i]);
+	printf(", SOG KMH %f\n", fix->sogk);
+}
 
 void nmea_tester(const NMEA_Message_t* test_) {
 	printf("--- NMEA TESTING ---\n\n");
 	if(!NMEA_Pack(&temp, test_msg)) printf("PACKING ERROR\n");
 
 	switch (temp.payloadId) {
+	case(NMEA_MSG_DTM): {
+		if (!NMEA_DTM_Parse(&frame_dtm, &temp))printf("PARSE ERROR\n");
+		else print_dtm(&frame_dtm);
+	}break;
 	case(NMEA_MSG_GBS): {
 		if (!NMEA_GBS_Parse(&frame_gbs, &temp))printf("PARSE ERROR\n");
 		else print_gbs(&frame_gbs);
@@ -100,6 +694,14 @@ void nmea_tester(const NMEA_Message_t* test_) {
 		if (!NMEA_GLL_Parse(&frame_gll, &temp))printf("PARSE ERROR\n");
 		else print_gll(&frame_gll);
 	}break;
+	case(NMEA_MSG_GNS): {
+		if (!NMEA_GNS_Parse(&frame_gns, &temp))printf("PARSE ERROR\n");
+		else print_gns(&frame_gns);
+	}break;
+	case(NMEA_MSG_GRS): {
+		if (!NMEA_GRS_Parse(&frame_grs, &temp))printf("PARSE ERROR\n");
+		else print_grs(&frame_grs);
+	}break;
 	case(NMEA_MSG_GSA): {
 		if (!NMEA_GSA_Parse(&frame_gsa, &temp))printf("PARSE ERROR\n");
 		else print_gsa(&frame_gsa);
@@ -116,6 +718,14 @@ void nmea_tester(const NMEA_Message_t* test_) {
 		if (!NMEA_RMC_Parse(&frame_rmc, &temp))printf("PARSE ERROR\n");
 		else print_rmc(&frame_rmc);
 	}break;
+	case(NMEA_MSG_TXT): {
+		if (!NMEA_TXT_Parse(&frame_txt, &temp))printf("PARSE ERROR\n");
+		else print_txt(&frame_txt);
+	}break;
+	case(NMEA_MSG_VLW): {
+		if (!NMEA_VLW_Parse(&frame_vlw, &temp))printf("PARSE ERROR\n");
+		else print_vlw(&frame_vlw);
+	}break;
 	case(NMEA_MSG_VTG): {
 		if (!NMEA_VTG_Parse(&frame_vtg, &temp))printf("PARSE ERROR\n");
 		else print_vtg(&frame_vtg);
@@ -132,12 +742,26 @@ void nmea_tester(const NMEA_Message_t* test_) {
 }
 
 
+void print_dtm(const NMEA_Payload_DTM_t* frame) {
+	printf("- PAYLOAD DTM -\n");
+
+	printf("DATUM : %s\n", frame->datum);
+	printf("SUB DATUM : %s\n", frame->subDatum);
+	printf("LAT OFFSET : %f\n", frame->latOffset);
+	printf("L_NORTH : %d\n", frame->ns_d);
+	printf("LON OFFSET : %f\n", frame->lonOffset);
+	printf("L_EAST : %d\n", frame->ew_d);
+	printf("ALT OFFSET : %f\n", frame->altOffset);
+	printf("REF DATUM : %s\n", frame->refDatum);
+}
+
 void print_gbs(const NMEA_Payload_GBS_t* frame) {
 	printf("- PAYLOAD GBS -\n");
 
 	printf("HOUR : %d\n", frame->time.hour);
 	printf("MIN : %d\n", frame->time.min);
 	printf("SEC : %d\n", frame->time.sec);
+	printf("MS : %d\n", frame->time.ms);
 	printf("ERRLAT : %f\n", frame->errLat);
 	printf("ERRLON : %f\n", frame->errLon);
 	printf("ERRALT : %f\n", frame->errAlt);
@@ -153,12 +777,18 @@ void print_gga(const NMEA_Payload_GGA_t* frame) {
 	printf("HOUR : %d\n", frame->time.hour);
 	printf("MIN : %d\n", frame->time.min);
 	printf("SEC : %d\n", frame->time.sec);
+	printf("MS : %d\n", frame->time.ms);
 	printf("LATITUDE : %d\n", frame->location.latitude);
 	printf("L_NORTH : %d\n", frame->location.ns_d);
 	printf("LONGITUDE : %d\n", frame->location.longitude);
 	printf("L_EAST : %d\n", frame->location.ew_d);
 	printf("QUALITY : %d\n", frame->quality);
 	printf("SATELLITE N : %d\n", frame->satellite_n);
+	printf("HDOP : %f\n", frame->hdop);
+	printf("ALTITUDE : %f\n", frame->altitude);
+	printf("SEPARATION : %f\n", frame->separation);
+	printf("DIFF AGE : %f\n", frame->diffAge);
+	printf("DIFF STATION : %d\n", frame->diffStation);
 }
 
 void print_gll(const NMEA_Payload_GLL_t* frame) {
@@ -167,6 +797,7 @@ void print_gll(const NMEA_Payload_GLL_t* frame) {
 	printf("HOUR : %d\n", frame->time.hour);
 	printf("MIN : %d\n", frame->time.min);
 	printf("SEC : %d\n", frame->time.sec);
+	printf("MS : %d\n", frame->time.ms);
 	printf("LATITUDE : %d\n", frame->location.latitude);
 	printf("L_NORTH : %d\n", frame->location.ns_d);
 	printf("LONGITUDE : %d\n", frame->location.longitude);
@@ -175,12 +806,49 @@ void print_gll(const NMEA_Payload_GLL_t* frame) {
 	printf("STATUS : %c\n", frame->status);
 }
 
+void print_gns(const NMEA_Payload_GNS_t* frame) {
+	printf("- PAYLOAD GNS -\n");
+
+	printf("HOUR : %d\n", frame->time.hour);
+	printf("MIN : %d\n", frame->time.min);
+	printf("SEC : %d\n", frame->time.sec);
+	printf("MS : %d\n", frame->time.ms);
+	printf("LATITUDE : %d\n", frame->location.latitude);
+	printf("L_NORTH : %d\n", frame->location.ns_d);
+	printf("LONGITUDE : %d\n", frame->location.longitude);
+	printf("L_EAST : %d\n", frame->location.ew_d);
+	printf("POSMODE : %s\n", frame->posMode);
+	printf("NUMSV : %d\n", frame->numSV);
+	printf("HDOP : %f\n", frame->hdop);
+	printf("ALTITUDE : %f\n", frame->altitude);
+	printf("SEPARATION : %f\n", frame->separation);
+	printf("DIFF AGE : %f\n", frame->diffAge);
+	printf("DIFF STATION : %d\n", frame->diffStation);
+	printf("NAVSTATUS : %c\n", frame->navStatus);
+}
+
+void print_grs(const NMEA_Payload_GRS_t* frame) {
+	printf("- PAYLOAD GRS -\n");
+
+	printf("HOUR : %d\n", frame->time.hour);
+	printf("MIN : %d\n", frame->time.min);
+	printf("SEC : %d\n", frame->time.sec);
+	printf("MS : %d\n", frame->time.ms);
+	printf("MODE : %d\n", frame->mode);
+	for (uint8_t i = 0; i < frame->residual_n; i++) {
+		printf("RESIDUAL %d : %f\n", i, frame->residual[i]);
+	}
+	printf("SYSTEM ID : %d\n", frame->systemId);
+	printf("SIGNAL ID : %d\n", frame->signalId);
+}
+
 void print_gst(const NMEA_Payload_GST_t* frame) {
 	printf("- PAYLOAD GST -\n");
 
 	printf("HOUR : %d\n", frame->time.hour);
 	printf("MIN : %d\n", frame->time.min);
 	printf("SEC : %d\n", frame->time.sec);
+	printf("MS : %d\n", frame->time.ms);
 	printf("RANGE RMS : %f\n", frame->rangeRms);
 	printf("STD MAJOR : %f\n", frame->stdMajor);
 	printf("STD MINOR : %f\n", frame->stdMinor);
@@ -222,6 +890,7 @@ void print_gsv(const NMEA_Payload_GSV_t* frame) {
 		printf("ELEVATION : %d\n", frame->sats[i].elevation);
 		printf("AZIMUTH : %d\n", frame->sats[i].azimuth);
 	}
+	printf("SIGNAL ID : %d\n", frame->signalId);
 }
 
 
@@ -231,6 +900,7 @@ void print_rmc(const NMEA_Payload_RMC_t* frame) {
 	printf("HOUR : %d\n", frame->time.hour);
 	printf("MIN : %d\n", frame->time.min);
 	printf("SEC : %d\n", frame->time.sec);
+	printf("MS : %d\n", frame->time.ms);
 
 	printf("STATUS : %c\n", frame->status);
 
@@ -249,6 +919,24 @@ void print_rmc(const NMEA_Payload_RMC_t* frame) {
 	printf("NAVSTATUS : %c\n", frame->navStatus);
 }
 
+void print_txt(const NMEA_Payload_TXT_t* frame) {
+	printf("- PAYLOAD TXT -\n");
+
+	printf("NUM MSG : %d\n", frame->numMsg);
+	printf("MSG NUM : %d\n", frame->msgNum);
+	printf("MSG TYPE : %d\n", frame->msgType);
+	printf("TEXT : %s\n", frame->text);
+}
+
+void print_vlw(const NMEA_Payload_VLW_t* frame) {
+	printf("- PAYLOAD VLW -\n");
+
+	printf("TWD : %f\n", frame->twd);
+	printf("WD : %f\n", frame->wd);
+	printf("TGD : %f\n", frame->tgd);
+	printf("GD : %f\n", frame->gd);
+}
+
 void print_vtg(const NMEA_Payload_VTG_t* frame) {
 	printf("- PAYLOAD VTG -\n");
 
@@ -265,6 +953,7 @@ void print_zda(const NMEA_Payload_ZDA_t* frame) {
 	printf("HOUR : %d\n", frame->time.hour);
 	printf("MIN : %d\n", frame->time.min);
 	printf("SEC : %d\n", frame->time.sec);
+	printf("MS : %d\n", frame->time.ms);
 
 	printf("DATE : %d : %d : %d \n", frame->date.day, frame->date.month, frame->date.year);
 }